@@ -186,6 +186,39 @@ Eigen::MatrixXd cyclopsGetFisherInformation(SEXP inRcppCcdInterface, const SEXP
     return interface->getCcd().computeFisherInformation(indices);
 }
 
+// [[Rcpp::export(".cyclopsGetAsymptoticVarianceDiagonal")]]
+std::vector<double> cyclopsGetAsymptoticVarianceDiagonal(SEXP inRcppCcdInterface, const SEXP sexpCovariates) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+
+	std::vector<size_t> indices;
+	if (!Rf_isNull(sexpCovariates)) {
+		ProfileVector covariates = as<ProfileVector>(sexpCovariates);
+		for (auto it = covariates.begin(); it != covariates.end(); ++it) {
+			indices.push_back(interface->getModelData().getColumnIndex(*it));
+		}
+	} else {
+		for (size_t index = 0; index < interface->getModelData().getNumberOfCovariates(); ++index) {
+			indices.push_back(index);
+		}
+	}
+
+	return interface->getCcd().computeAsymptoticVarianceDiagonal(indices);
+}
+
+// [[Rcpp::export(".cyclopsGetCrossTermCacheStatistics")]]
+Rcpp::NumericVector cyclopsGetCrossTermCacheStatistics(SEXP inRcppCcdInterface) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+
+	const CacheStatistics statistics = interface->getCcd().getCrossTermCacheStatistics();
+	return Rcpp::NumericVector::create(
+		Rcpp::Named("hits") = statistics.hits,
+		Rcpp::Named("misses") = statistics.misses,
+		Rcpp::Named("evictions") = statistics.evictions,
+		Rcpp::Named("bytes") = static_cast<double>(statistics.bytes));
+}
+
 // // [[Rcpp::export("test")]]
 // void cyclopsTest(std::vector<int> map, std::vector<std::vector<int> > list) {
 //     for(auto it = begin(map); it != end(map); ++it) {
@@ -332,11 +365,24 @@ DataFrame cyclopsGetProfileLikelihood(SEXP inRcppCcdInterface,
     const IdType covariate = as<IdType>(inCovariate);
 
     std::vector<double> values(points.size());
-    interface->evaluateProfileModel(covariate, points, values, threads, includePenalty);
+    std::vector<ProfilePointInformation> information(points.size());
+    interface->evaluateProfileModel(covariate, points, values, information, threads, includePenalty);
+
+    std::vector<int> iterations;
+    std::vector<bool> converged;
+    std::vector<double> start;
+    for (const auto& point : information) {
+        iterations.push_back(point.iterations);
+        converged.push_back(point.status == SUCCESS);
+        start.push_back(point.start);
+    }
 
     return DataFrame::create(
         Rcpp::Named("point") = points,
-        Rcpp::Named("value") = values
+        Rcpp::Named("value") = values,
+        Rcpp::Named("iterations") = iterations,
+        Rcpp::Named("converged") = converged,
+        Rcpp::Named("start") = start
     );
 }
 
@@ -394,7 +440,10 @@ void cyclopsSetControl(SEXP inRcppCcdInterface,
 		bool useAutoSearch, int fold, int foldToCompute, double lowerLimit, double upperLimit, int gridSteps,
 		const std::string& noiseLevel, int threads, int seed, bool resetCoefficients, double startingVariance,
         bool useKKTSwindle, int swindleMultipler, const std::string& selectorType, double initialBound,
-        int maxBoundCount, const std::string& algorithm
+        int maxBoundCount, const std::string& algorithm, const std::string& coordinateSelection,
+        double hybridFraction, int quasiNewton, int newtonThreshold, int gramThreshold,
+        bool safeScreening, int crossTermCacheSize, bool approximateLeaveOut,
+        const std::vector<double>& subsampleProportions, int gridLanes
 		) {
 	using namespace bsccs;
 	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
@@ -409,15 +458,30 @@ void cyclopsSetControl(SEXP inRcppCcdInterface,
     args.modeFinding.maxBoundCount = maxBoundCount;
     if (algorithm == "mm") {
         args.modeFinding.algorithmType = AlgorithmType::MM;
+    } else if (algorithm == "newton") {
+        args.modeFinding.algorithmType = AlgorithmType::NEWTON;
+    } else if (algorithm == "fista") {
+        args.modeFinding.algorithmType = AlgorithmType::FISTA;
+    } else if (algorithm == "irls") {
+        args.modeFinding.algorithmType = AlgorithmType::IRLS;
     }
+    args.modeFinding.coordinateSelection = RcppCcdInterface::parseCoordinateSelectionType(coordinateSelection);
+    args.modeFinding.hybridFraction = hybridFraction;
+    args.modeFinding.qnQ = quasiNewton;
+    args.modeFinding.newtonThreshold = newtonThreshold;
+    args.modeFinding.gramThreshold = gramThreshold;
+    args.modeFinding.useSafeScreening = safeScreening;
+    args.modeFinding.crossTermCacheSize = crossTermCacheSize;
 
 	// Cross validation control
 	args.crossValidation.useAutoSearchCV = useAutoSearch;
+	args.crossValidation.useApproximateLeaveOut = approximateLeaveOut;
 	args.crossValidation.fold = fold;
 	args.crossValidation.foldToCompute = foldToCompute;
 	args.crossValidation.lowerLimit = lowerLimit;
 	args.crossValidation.upperLimit = upperLimit;
 	args.crossValidation.gridSteps = gridSteps;
+	args.crossValidation.gridLanes = gridLanes;
 	args.crossValidation.startingVariance = startingVariance;
 	args.crossValidation.selectorType = RcppCcdInterface::parseSelectorType(selectorType);
 
@@ -426,7 +490,9 @@ void cyclopsSetControl(SEXP inRcppCcdInterface,
 	interface->setNoiseLevel(noise);
 	args.threads = threads;
 	args.seed = seed;
+	args.modeFinding.seed = seed;
 	args.resetCoefficients = resetCoefficients;
+	args.subsampleProportions = subsampleProportions;
 }
 
 // [[Rcpp::export(".cyclopsRunCrossValidation")]]
@@ -464,6 +530,109 @@ List cyclopsFitModel(SEXP inRcppCcdInterface) {
 	return list;
 }
 
+// [[Rcpp::export(".cyclopsFitOutcomes")]]
+List cyclopsFitOutcomes(SEXP inRcppCcdInterface, const NumericMatrix& outcomes) {
+	using namespace bsccs;
+
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+	auto& ccd = interface->getCcd();
+	auto& data = interface->getModelData();
+
+	std::vector<double> estimates;
+	std::vector<double> logLikelihoods;
+	std::vector<UpdateReturnFlags> returnFlags;
+	double timeUpdate = interface->fitOutcomes(
+		std::vector<double>(outcomes.begin(), outcomes.end()), outcomes.ncol(),
+		estimates, logLikelihoods, returnFlags);
+
+	const int J = ccd.getBetaSize();
+	const int offset = data.getHasOffsetCovariate() ? 1 : 0;
+
+	NumericMatrix coefficients(J - offset, outcomes.ncol());
+	std::vector<std::string> flags;
+	for (int m = 0; m < outcomes.ncol(); ++m) {
+		for (int j = offset; j < J; ++j) {
+			coefficients(j - offset, m) = estimates[static_cast<size_t>(m) * J + j];
+		}
+		flags.push_back(DiagnosticsOutputWriter::returnFlagString(returnFlags[m]));
+	}
+
+	return List::create(
+			Rcpp::Named("estimates") = coefficients,
+			Rcpp::Named("log_likelihood") = logLikelihoods,
+			Rcpp::Named("return_flag") = flags,
+			Rcpp::Named("timeFit") = timeUpdate
+		);
+}
+
+// [[Rcpp::export(".cyclopsGetScoreStatistics")]]
+DataFrame cyclopsGetScoreStatistics(SEXP inRcppCcdInterface, SEXP sexpCovariates, int threads) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+	auto& data = interface->getModelData();
+
+	std::vector<int> indices;
+	if (!Rf_isNull(sexpCovariates)) {
+		ProfileVector covariates = as<ProfileVector>(sexpCovariates);
+		for (auto it = covariates.begin(); it != covariates.end(); ++it) {
+			indices.push_back(data.getColumnIndex(*it));
+		}
+	} else {
+		const int offset = data.getHasOffsetCovariate() ? 1 : 0;
+		for (size_t index = offset; index < data.getNumberOfCovariates(); ++index) {
+			indices.push_back(index);
+		}
+	}
+
+	std::vector<double> statistics;
+	interface->getScoreStatistics(indices, statistics, threads);
+
+	std::vector<double> covariates;
+	for (int index : indices) {
+		covariates.push_back(data.getColumnNumericalLabel(index));
+	}
+
+	return DataFrame::create(
+		Rcpp::Named("covariate") = covariates,
+		Rcpp::Named("statistic") = statistics
+	);
+}
+
+// [[Rcpp::export(".cyclopsFitUnivariable")]]
+List cyclopsFitUnivariable(SEXP inRcppCcdInterface, SEXP sexpCovariates) {
+	using namespace bsccs;
+
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+
+	std::vector<int> candidates;
+	ProfileVector covariates = as<ProfileVector>(sexpCovariates);
+	for (auto it = covariates.begin(); it != covariates.end(); ++it) {
+		candidates.push_back(interface->getModelData().getColumnIndex(*it));
+	}
+
+	double baseLogLikelihood;
+	std::vector<double> estimates;
+	std::vector<double> standardErrors;
+	std::vector<double> statistics;
+	std::vector<UpdateReturnFlags> returnFlags;
+	double timeUpdate = interface->fitUnivariable(candidates, baseLogLikelihood,
+		estimates, standardErrors, statistics, returnFlags);
+
+	std::vector<std::string> flags;
+	for (auto flag : returnFlags) {
+		flags.push_back(DiagnosticsOutputWriter::returnFlagString(flag));
+	}
+
+	return List::create(
+			Rcpp::Named("estimates") = estimates,
+			Rcpp::Named("std_errors") = standardErrors,
+			Rcpp::Named("statistics") = statistics,
+			Rcpp::Named("base_log_likelihood") = baseLogLikelihood,
+			Rcpp::Named("return_flag") = flags,
+			Rcpp::Named("timeFit") = timeUpdate
+		);
+}
+
 // [[Rcpp::export(".cyclopsLogModel")]]
 List cyclopsLogModel(SEXP inRcppCcdInterface) {
 	using namespace bsccs;
@@ -646,6 +815,23 @@ bsccs::SelectorType RcppCcdInterface::parseSelectorType(const std::string& selec
 	 return selectorType;
 }
 
+bsccs::CoordinateSelectionType RcppCcdInterface::parseCoordinateSelectionType(const std::string& selectionName) {
+    using namespace bsccs;
+    CoordinateSelectionType selectionType = CoordinateSelectionType::CYCLIC;
+    if (selectionName == "cyclic") {
+        selectionType = CoordinateSelectionType::CYCLIC;
+    } else if (selectionName == "random") {
+        selectionType = CoordinateSelectionType::RANDOM;
+    } else if (selectionName == "greedy") {
+        selectionType = CoordinateSelectionType::GREEDY;
+    } else if (selectionName == "hybrid") {
+        selectionType = CoordinateSelectionType::HYBRID;
+    } else {
+        handleError("Invalid coordinate selection type.");
+    }
+    return selectionType;
+}
+
 bsccs::NormalizationType RcppCcdInterface::parseNormalizationType(const std::string& normalizationName) {
     using namespace bsccs;
     NormalizationType normalizationType = NormalizationType::STANDARD_DEVIATION;
@@ -961,8 +1147,17 @@ void RcppCcdInterface::predictModelImpl(CyclicCoordinateDescent *ccd, AbstractMo
     //std::vector<double> predictions(ccd->getPredictionSize());
     ccd->getPredictiveEstimates(&predictions[0], NULL);
 
+    const auto& rowMap = modelData->getAggregatedRowMap();
+    if (!rowMap.empty()) { // Map aggregated rows back to original rows
+        NumericVector expanded(rowMap.size());
+        for (size_t i = 0; i < rowMap.size(); ++i) {
+            expanded[i] = predictions[rowMap[i]];
+        }
+        predictions = expanded;
+    }
+
     if (modelData->getHasRowLabels()) {
-        size_t preds = ccd->getPredictionSize();
+        size_t preds = predictions.size();
         CharacterVector labels(preds);
         for (size_t i = 0; i < preds; ++i) {
             labels[i] = modelData->getRowLabel(i);
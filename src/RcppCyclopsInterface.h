@@ -37,6 +37,24 @@ public:
     	return CcdInterface::fitModel(ccd);
     }
 
+    double fitOutcomes(const std::vector<double>& outcomes, int outcomeCount,
+                       std::vector<double>& estimates, std::vector<double>& logLikelihoods,
+                       std::vector<UpdateReturnFlags>& returnFlags) {
+    	return CcdInterface::fitOutcomes(ccd, outcomes, outcomeCount, estimates, logLikelihoods,
+    			returnFlags);
+    }
+
+    double fitUnivariable(const std::vector<int>& candidates, double& baseLogLikelihood,
+                          std::vector<double>& estimates, std::vector<double>& standardErrors,
+                          std::vector<double>& statistics, std::vector<UpdateReturnFlags>& returnFlags) {
+    	return CcdInterface::fitUnivariable(ccd, candidates, baseLogLikelihood, estimates,
+    			standardErrors, statistics, returnFlags);
+    }
+
+    double getScoreStatistics(std::vector<int>& indices, std::vector<double>& statistics, int threads) {
+    	return CcdInterface::getScoreStatistics(ccd, indices, statistics, threads);
+    }
+
     double runFitMLEAtMode() {
     	return CcdInterface::runFitMLEAtMode(ccd);
     }
@@ -55,8 +73,10 @@ public:
     double evaluateProfileModel(const IdType covariate,
                                 const std::vector<double>& points,
                                 std::vector<double>& values,
+                                std::vector<ProfilePointInformation>& information,
                                 int threads, bool includePenalty) {
-        return CcdInterface::evaluateProfileModel(ccd, modelData, covariate, points, values, threads, includePenalty);
+        return CcdInterface::evaluateProfileModel(ccd, modelData, covariate, points, values, information,
+                                                  threads, includePenalty);
     }
 
     double runCrossValidation() {
@@ -108,6 +128,7 @@ public:
     static NoiseLevels parseNoiseLevel(const std::string& noiseName);
   	static SelectorType parseSelectorType(const std::string& selectorName);
   	static NormalizationType parseNormalizationType(const std::string& normalizationName);
+  	static CoordinateSelectionType parseCoordinateSelectionType(const std::string& selectionName);
 
 protected:
 
@@ -150,6 +150,29 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cyclopsGetAsymptoticVarianceDiagonal
+std::vector<double> cyclopsGetAsymptoticVarianceDiagonal(SEXP inRcppCcdInterface, const SEXP sexpCovariates);
+RcppExport SEXP _Cyclops_cyclopsGetAsymptoticVarianceDiagonal(SEXP inRcppCcdInterfaceSEXP, SEXP sexpCovariatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< const SEXP >::type sexpCovariates(sexpCovariatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetAsymptoticVarianceDiagonal(inRcppCcdInterface, sexpCovariates));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cyclopsGetCrossTermCacheStatistics
+Rcpp::NumericVector cyclopsGetCrossTermCacheStatistics(SEXP inRcppCcdInterface);
+RcppExport SEXP _Cyclops_cyclopsGetCrossTermCacheStatistics(SEXP inRcppCcdInterfaceSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetCrossTermCacheStatistics(inRcppCcdInterface));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsSetPrior
 void cyclopsSetPrior(SEXP inRcppCcdInterface, const std::vector<std::string>& priorTypeName, const std::vector<double>& variance, SEXP excludeNumeric, SEXP sexpGraph, Rcpp::List sexpNeighborhood);
 RcppExport SEXP _Cyclops_cyclopsSetPrior(SEXP inRcppCcdInterfaceSEXP, SEXP priorTypeNameSEXP, SEXP varianceSEXP, SEXP excludeNumericSEXP, SEXP sexpGraphSEXP, SEXP sexpNeighborhoodSEXP) {
@@ -236,8 +259,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // cyclopsSetControl
-void cyclopsSetControl(SEXP inRcppCcdInterface, int maxIterations, double tolerance, const std::string& convergenceType, bool useAutoSearch, int fold, int foldToCompute, double lowerLimit, double upperLimit, int gridSteps, const std::string& noiseLevel, int threads, int seed, bool resetCoefficients, double startingVariance, bool useKKTSwindle, int swindleMultipler, const std::string& selectorType, double initialBound, int maxBoundCount, const std::string& algorithm);
-RcppExport SEXP _Cyclops_cyclopsSetControl(SEXP inRcppCcdInterfaceSEXP, SEXP maxIterationsSEXP, SEXP toleranceSEXP, SEXP convergenceTypeSEXP, SEXP useAutoSearchSEXP, SEXP foldSEXP, SEXP foldToComputeSEXP, SEXP lowerLimitSEXP, SEXP upperLimitSEXP, SEXP gridStepsSEXP, SEXP noiseLevelSEXP, SEXP threadsSEXP, SEXP seedSEXP, SEXP resetCoefficientsSEXP, SEXP startingVarianceSEXP, SEXP useKKTSwindleSEXP, SEXP swindleMultiplerSEXP, SEXP selectorTypeSEXP, SEXP initialBoundSEXP, SEXP maxBoundCountSEXP, SEXP algorithmSEXP) {
+void cyclopsSetControl(SEXP inRcppCcdInterface, int maxIterations, double tolerance, const std::string& convergenceType, bool useAutoSearch, int fold, int foldToCompute, double lowerLimit, double upperLimit, int gridSteps, const std::string& noiseLevel, int threads, int seed, bool resetCoefficients, double startingVariance, bool useKKTSwindle, int swindleMultipler, const std::string& selectorType, double initialBound, int maxBoundCount, const std::string& algorithm, const std::string& coordinateSelection, double hybridFraction, int quasiNewton, int newtonThreshold, int gramThreshold, bool safeScreening, int crossTermCacheSize, bool approximateLeaveOut, const std::vector<double>& subsampleProportions, int gridLanes);
+RcppExport SEXP _Cyclops_cyclopsSetControl(SEXP inRcppCcdInterfaceSEXP, SEXP maxIterationsSEXP, SEXP toleranceSEXP, SEXP convergenceTypeSEXP, SEXP useAutoSearchSEXP, SEXP foldSEXP, SEXP foldToComputeSEXP, SEXP lowerLimitSEXP, SEXP upperLimitSEXP, SEXP gridStepsSEXP, SEXP noiseLevelSEXP, SEXP threadsSEXP, SEXP seedSEXP, SEXP resetCoefficientsSEXP, SEXP startingVarianceSEXP, SEXP useKKTSwindleSEXP, SEXP swindleMultiplerSEXP, SEXP selectorTypeSEXP, SEXP initialBoundSEXP, SEXP maxBoundCountSEXP, SEXP algorithmSEXP, SEXP coordinateSelectionSEXP, SEXP hybridFractionSEXP, SEXP quasiNewtonSEXP, SEXP newtonThresholdSEXP, SEXP gramThresholdSEXP, SEXP safeScreeningSEXP, SEXP crossTermCacheSizeSEXP, SEXP approximateLeaveOutSEXP, SEXP subsampleProportionsSEXP, SEXP gridLanesSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
@@ -261,7 +284,17 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< double >::type initialBound(initialBoundSEXP);
     Rcpp::traits::input_parameter< int >::type maxBoundCount(maxBoundCountSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type algorithm(algorithmSEXP);
-    cyclopsSetControl(inRcppCcdInterface, maxIterations, tolerance, convergenceType, useAutoSearch, fold, foldToCompute, lowerLimit, upperLimit, gridSteps, noiseLevel, threads, seed, resetCoefficients, startingVariance, useKKTSwindle, swindleMultipler, selectorType, initialBound, maxBoundCount, algorithm);
+    Rcpp::traits::input_parameter< const std::string& >::type coordinateSelection(coordinateSelectionSEXP);
+    Rcpp::traits::input_parameter< double >::type hybridFraction(hybridFractionSEXP);
+    Rcpp::traits::input_parameter< int >::type quasiNewton(quasiNewtonSEXP);
+    Rcpp::traits::input_parameter< int >::type newtonThreshold(newtonThresholdSEXP);
+    Rcpp::traits::input_parameter< int >::type gramThreshold(gramThresholdSEXP);
+    Rcpp::traits::input_parameter< bool >::type safeScreening(safeScreeningSEXP);
+    Rcpp::traits::input_parameter< int >::type crossTermCacheSize(crossTermCacheSizeSEXP);
+    Rcpp::traits::input_parameter< bool >::type approximateLeaveOut(approximateLeaveOutSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type subsampleProportions(subsampleProportionsSEXP);
+    Rcpp::traits::input_parameter< int >::type gridLanes(gridLanesSEXP);
+    cyclopsSetControl(inRcppCcdInterface, maxIterations, tolerance, convergenceType, useAutoSearch, fold, foldToCompute, lowerLimit, upperLimit, gridSteps, noiseLevel, threads, seed, resetCoefficients, startingVariance, useKKTSwindle, swindleMultipler, selectorType, initialBound, maxBoundCount, algorithm, coordinateSelection, hybridFraction, quasiNewton, newtonThreshold, gramThreshold, safeScreening, crossTermCacheSize, approximateLeaveOut, subsampleProportions, gridLanes);
     return R_NilValue;
 END_RCPP
 }
@@ -287,6 +320,43 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cyclopsFitOutcomes
+List cyclopsFitOutcomes(SEXP inRcppCcdInterface, const NumericMatrix& outcomes);
+RcppExport SEXP _Cyclops_cyclopsFitOutcomes(SEXP inRcppCcdInterfaceSEXP, SEXP outcomesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type outcomes(outcomesSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsFitOutcomes(inRcppCcdInterface, outcomes));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cyclopsGetScoreStatistics
+DataFrame cyclopsGetScoreStatistics(SEXP inRcppCcdInterface, SEXP sexpCovariates, int threads);
+RcppExport SEXP _Cyclops_cyclopsGetScoreStatistics(SEXP inRcppCcdInterfaceSEXP, SEXP sexpCovariatesSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type sexpCovariates(sexpCovariatesSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetScoreStatistics(inRcppCcdInterface, sexpCovariates, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cyclopsFitUnivariable
+List cyclopsFitUnivariable(SEXP inRcppCcdInterface, SEXP sexpCovariates);
+RcppExport SEXP _Cyclops_cyclopsFitUnivariable(SEXP inRcppCcdInterfaceSEXP, SEXP sexpCovariatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type sexpCovariates(sexpCovariatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsFitUnivariable(inRcppCcdInterface, sexpCovariates));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsLogModel
 List cyclopsLogModel(SEXP inRcppCcdInterface);
 RcppExport SEXP _Cyclops_cyclopsLogModel(SEXP inRcppCcdInterfaceSEXP) {
@@ -626,8 +696,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // cyclopsFinalizeData
-void cyclopsFinalizeData(Environment x, bool addIntercept, SEXP sexpOffsetCovariate, bool offsetAlreadyOnLogScale, bool sortCovariates, SEXP sexpCovariatesDense, bool magicFlag);
-RcppExport SEXP _Cyclops_cyclopsFinalizeData(SEXP xSEXP, SEXP addInterceptSEXP, SEXP sexpOffsetCovariateSEXP, SEXP offsetAlreadyOnLogScaleSEXP, SEXP sortCovariatesSEXP, SEXP sexpCovariatesDenseSEXP, SEXP magicFlagSEXP) {
+void cyclopsFinalizeData(Environment x, bool addIntercept, SEXP sexpOffsetCovariate, bool offsetAlreadyOnLogScale, bool sortCovariates, SEXP sexpCovariatesDense, bool mergeDuplicateCovariates, bool aggregateRows, bool magicFlag);
+RcppExport SEXP _Cyclops_cyclopsFinalizeData(SEXP xSEXP, SEXP addInterceptSEXP, SEXP sexpOffsetCovariateSEXP, SEXP offsetAlreadyOnLogScaleSEXP, SEXP sortCovariatesSEXP, SEXP sexpCovariatesDenseSEXP, SEXP mergeDuplicateCovariatesSEXP, SEXP aggregateRowsSEXP, SEXP magicFlagSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< Environment >::type x(xSEXP);
@@ -636,11 +706,24 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< bool >::type offsetAlreadyOnLogScale(offsetAlreadyOnLogScaleSEXP);
     Rcpp::traits::input_parameter< bool >::type sortCovariates(sortCovariatesSEXP);
     Rcpp::traits::input_parameter< SEXP >::type sexpCovariatesDense(sexpCovariatesDenseSEXP);
+    Rcpp::traits::input_parameter< bool >::type mergeDuplicateCovariates(mergeDuplicateCovariatesSEXP);
+    Rcpp::traits::input_parameter< bool >::type aggregateRows(aggregateRowsSEXP);
     Rcpp::traits::input_parameter< bool >::type magicFlag(magicFlagSEXP);
-    cyclopsFinalizeData(x, addIntercept, sexpOffsetCovariate, offsetAlreadyOnLogScale, sortCovariates, sexpCovariatesDense, magicFlag);
+    cyclopsFinalizeData(x, addIntercept, sexpOffsetCovariate, offsetAlreadyOnLogScale, sortCovariates, sexpCovariatesDense, mergeDuplicateCovariates, aggregateRows, magicFlag);
     return R_NilValue;
 END_RCPP
 }
+// cyclopsGetDuplicateCovariates
+List cyclopsGetDuplicateCovariates(Environment object);
+RcppExport SEXP _Cyclops_cyclopsGetDuplicateCovariates(SEXP objectSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Environment >::type object(objectSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetDuplicateCovariates(object));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsLoadDataY
 void cyclopsLoadDataY(Environment x, const std::vector<int64_t>& stratumId, const std::vector<int64_t>& rowId, const std::vector<double>& y, const std::vector<double>& time);
 RcppExport SEXP _Cyclops_cyclopsLoadDataY(SEXP xSEXP, SEXP stratumIdSEXP, SEXP rowIdSEXP, SEXP ySEXP, SEXP timeSEXP) {
@@ -767,15 +850,20 @@ static const R_CallMethodDef CallEntries[] = {
     {"_Cyclops_cyclopsGetNewPredictiveLogLikelihood", (DL_FUNC) &_Cyclops_cyclopsGetNewPredictiveLogLikelihood, 2},
     {"_Cyclops_cyclopsGetLogLikelihood", (DL_FUNC) &_Cyclops_cyclopsGetLogLikelihood, 1},
     {"_Cyclops_cyclopsGetFisherInformation", (DL_FUNC) &_Cyclops_cyclopsGetFisherInformation, 2},
+    {"_Cyclops_cyclopsGetAsymptoticVarianceDiagonal", (DL_FUNC) &_Cyclops_cyclopsGetAsymptoticVarianceDiagonal, 2},
+    {"_Cyclops_cyclopsGetCrossTermCacheStatistics", (DL_FUNC) &_Cyclops_cyclopsGetCrossTermCacheStatistics, 1},
     {"_Cyclops_cyclopsSetPrior", (DL_FUNC) &_Cyclops_cyclopsSetPrior, 6},
     {"_Cyclops_cyclopsTestParameterizedPrior", (DL_FUNC) &_Cyclops_cyclopsTestParameterizedPrior, 4},
     {"_Cyclops_cyclopsSetParameterizedPrior", (DL_FUNC) &_Cyclops_cyclopsSetParameterizedPrior, 5},
     {"_Cyclops_cyclopsGetProfileLikelihood", (DL_FUNC) &_Cyclops_cyclopsGetProfileLikelihood, 5},
     {"_Cyclops_cyclopsProfileModel", (DL_FUNC) &_Cyclops_cyclopsProfileModel, 6},
     {"_Cyclops_cyclopsPredictModel", (DL_FUNC) &_Cyclops_cyclopsPredictModel, 1},
-    {"_Cyclops_cyclopsSetControl", (DL_FUNC) &_Cyclops_cyclopsSetControl, 21},
+    {"_Cyclops_cyclopsSetControl", (DL_FUNC) &_Cyclops_cyclopsSetControl, 31},
     {"_Cyclops_cyclopsRunCrossValidationl", (DL_FUNC) &_Cyclops_cyclopsRunCrossValidationl, 1},
     {"_Cyclops_cyclopsFitModel", (DL_FUNC) &_Cyclops_cyclopsFitModel, 1},
+    {"_Cyclops_cyclopsFitOutcomes", (DL_FUNC) &_Cyclops_cyclopsFitOutcomes, 2},
+    {"_Cyclops_cyclopsGetScoreStatistics", (DL_FUNC) &_Cyclops_cyclopsGetScoreStatistics, 3},
+    {"_Cyclops_cyclopsFitUnivariable", (DL_FUNC) &_Cyclops_cyclopsFitUnivariable, 2},
     {"_Cyclops_cyclopsLogModel", (DL_FUNC) &_Cyclops_cyclopsLogModel, 1},
     {"_Cyclops_cyclopsInitializeModel", (DL_FUNC) &_Cyclops_cyclopsInitializeModel, 4},
     {"_Cyclops_isSorted", (DL_FUNC) &_Cyclops_isSorted, 3},
@@ -805,7 +893,8 @@ static const R_CallMethodDef CallEntries[] = {
     {"_Cyclops_cyclopsGetMeanOffset", (DL_FUNC) &_Cyclops_cyclopsGetMeanOffset, 1},
     {"_Cyclops_cyclopsGetYVector", (DL_FUNC) &_Cyclops_cyclopsGetYVector, 1},
     {"_Cyclops_cyclopsGetTimeVector", (DL_FUNC) &_Cyclops_cyclopsGetTimeVector, 1},
-    {"_Cyclops_cyclopsFinalizeData", (DL_FUNC) &_Cyclops_cyclopsFinalizeData, 7},
+    {"_Cyclops_cyclopsFinalizeData", (DL_FUNC) &_Cyclops_cyclopsFinalizeData, 9},
+    {"_Cyclops_cyclopsGetDuplicateCovariates", (DL_FUNC) &_Cyclops_cyclopsGetDuplicateCovariates, 1},
     {"_Cyclops_cyclopsLoadDataY", (DL_FUNC) &_Cyclops_cyclopsLoadDataY, 5},
     {"_Cyclops_cyclopsLoadDataMultipleX", (DL_FUNC) &_Cyclops_cyclopsLoadDataMultipleX, 8},
     {"_Cyclops_cyclopsLoadDataX", (DL_FUNC) &_Cyclops_cyclopsLoadDataX, 7},
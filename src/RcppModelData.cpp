@@ -469,6 +469,8 @@ void cyclopsFinalizeData(
         bool offsetAlreadyOnLogScale,
         bool sortCovariates,
         SEXP sexpCovariatesDense,
+        bool mergeDuplicateCovariates,
+        bool aggregateRows,
         bool magicFlag = false) {
     using namespace bsccs;
     XPtr<AbstractModelData> data = parseEnvironmentForPtr(x);
@@ -542,9 +544,39 @@ void cyclopsFinalizeData(
         }
     }
 
+    if (mergeDuplicateCovariates) {
+        data->findDuplicateCovariates();
+    }
+
+    if (aggregateRows) {
+        data->aggregateRows();
+    }
+
     data->setIsFinalized(true);
 }
 
+// [[Rcpp::export(".cyclopsGetDuplicateCovariates")]]
+List cyclopsGetDuplicateCovariates(Environment object) {
+    using namespace bsccs;
+    XPtr<bsccs::AbstractModelData> data = parseEnvironmentForPtr(object);
+
+    auto label = [&data](const int index) {
+        return (index == -1) ? NA_REAL : static_cast<double>(data->getColumnNumericalLabel(index));
+    };
+
+    std::vector<double> duplicateOf;
+    std::vector<double> complementOf;
+    size_t i = 0;
+    if (data->getHasOffsetCovariate()) i++;
+    for (; i < data->getNumberOfCovariates(); ++i) {
+        duplicateOf.push_back(label(data->getDuplicateOf(i)));
+        complementOf.push_back(label(data->getComplementOf(i)));
+    }
+    return List::create(
+        Rcpp::Named("duplicateOf") = duplicateOf,
+        Rcpp::Named("complementOf") = complementOf);
+}
+
 
 // [[Rcpp::export(".loadCyclopsDataY")]]
 void cyclopsLoadDataY(Environment x,
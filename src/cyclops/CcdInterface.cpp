@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <numeric>
 
 #include <iostream>
 #include <time.h>
@@ -46,6 +47,7 @@
 // #include "io/OutputWriter.h"
 #include "drivers/CrossValidationSelector.h"
 #include "drivers/GridSearchCrossValidationDriver.h"
+#include "drivers/ApproximateLeaveOutCrossValidationDriver.h"
 #include "drivers/HierarchyGridSearchCrossValidationDriver.h"
 #include "drivers/AutoSearchCrossValidationDriver.h"
 #include "drivers/HierarchyAutoSearchCrossValidationDriver.h"
@@ -235,9 +237,34 @@ struct OptimizationProfile {
 		return nEvals;
 	}
 
+	// Refits start from the nearest previously evaluated point instead of wherever ccd was left; only the
+	// points closest to the latest one are kept
+	void addStart(double x, const std::vector<double>& beta) {
+		if (starts.size() < maxStarts) {
+			starts.push_back(std::make_pair(x, beta));
+		} else {
+			auto farthest = std::max_element(starts.begin(), starts.end(),
+				[x](const Start& lhs, const Start& rhs) {
+					return std::abs(lhs.first - x) < std::abs(rhs.first - x);
+				});
+			farthest->first = x;
+			farthest->second = beta;
+		}
+	}
+
 	double objective(double x) {
 		++nEvals;
-		ccd.setBeta(index, x);
+		if (!starts.empty()) {
+			auto nearest = std::min_element(starts.begin(), starts.end(),
+				[x](const Start& lhs, const Start& rhs) {
+					return std::abs(lhs.first - x) < std::abs(rhs.first - x);
+				});
+			std::vector<double> beta = nearest->second;
+			beta[index] = x;
+			ccd.setBeta(beta);
+		} else {
+			ccd.setBeta(index, x);
+		}
 		ccd.setFixedBeta(index, true);
 		ccd.update(arguments.modeFinding);
 		ccd.setFixedBeta(index, false);
@@ -245,9 +272,26 @@ struct OptimizationProfile {
 		if (includePenalty) {
 			y += ccd.getLogPrior();
 		}
+		if (!starts.empty()) {
+			std::vector<double> beta(ccd.getBetaSize());
+			for (int j = 0; j < static_cast<int>(beta.size()); ++j) {
+				beta[j] = ccd.getBeta(j);
+			}
+			addStart(x, beta);
+		}
 		return y;
 	}
 
+	// Slope of the profile at the last objective(); the other coefficients are at their optimum.  NaN where
+	// the prior has no derivative, which leaves findRoot() with secant and bisection steps
+	double derivative() {
+		double slope = ccd.getLogLikelihoodGradient(index);
+		if (includePenalty) {
+			slope += ccd.getLogPriorGradient(index);
+		}
+		return slope;
+	}
+
 	double getMaximum() {
 		return threshold;
 	}
@@ -257,6 +301,10 @@ struct OptimizationProfile {
 	double threshold;
 	int nEvals;
 	bool includePenalty;
+
+	typedef std::pair<double, std::vector<double>> Start;
+	std::vector<Start> starts;
+	static const size_t maxStarts = 4;
 };
 
 double CcdInterface::profileModel(CyclicCoordinateDescent *ccd, AbstractModelData *modelData,
@@ -322,6 +370,9 @@ double CcdInterface::profileModel(CyclicCoordinateDescent *ccd, AbstractModelDat
 
 	for (int i = 1; i < nThreads; ++i) {
 	    ccdPool.push_back(ccd->clone());
+	    if (ccdPool.back()) {
+	        ccdPool.back()->setCoordinateStream(i);
+	    }
 	}
 
     std::vector<double> lowerPts(indices.size());
@@ -342,16 +393,19 @@ double CcdInterface::profileModel(CyclicCoordinateDescent *ccd, AbstractModelDat
 
 	    // Bound edge
 	    OptimizationProfile eval(*ccd, arguments, index, mode, threshold, includePenalty);
+	    eval.addStart(x0, x0s);
 	    RZeroIn<OptimizationProfile> zeroIn(eval, 1E-3);
 
 	    double obj0 = eval.getMaximum();
 
-	    //		std::cout << "BEGIN UP bracket" << std::endl;
-	    RZeroIn<OptimizationProfile>::Coordinate bracket =
-	        zeroIn.bracketSignChange(x0, obj0, direction);
-	     //		std::cout << "END UP bracket " << bracket.first << " " << bracket.second << std::endl;
+	    // Start from the Wald bound at the mode
+	    ccd->setBeta(x0s);
+	    const double curvature = ccd->getHessianDiagonal(index);
+	    const double step = (curvature > 0.0) ?
+	        std::sqrt(2.0 * threshold / curvature) :
+	        0.1 * std::max(std::abs(x0), 0.01);
 
-	    double pt = std::isnan(bracket.second) ? NAN : zeroIn.getRoot(x0, bracket.first, obj0, bracket.second);
+	    double pt = zeroIn.findRoot(x0, obj0, direction, x0 + direction * step);
 
 	    if (direction == 1.0) {
 	        upperPts[id] = pt;
@@ -528,6 +582,7 @@ double CcdInterface::evaluateProfileModel(CyclicCoordinateDescent *ccd, Abstract
                                           const IdType covariate,
                                           const std::vector<double>& points,
                                           std::vector<double>& values,
+                                          std::vector<ProfilePointInformation>& information,
                                           int inThreads,
                                           bool includePenalty) {
 
@@ -545,6 +600,7 @@ double CcdInterface::evaluateProfileModel(CyclicCoordinateDescent *ccd, Abstract
     // Parallelize across grid values
     int nThreads = (inThreads == -1) ?
     bsccs::thread::hardware_concurrency() : inThreads;
+    nThreads = std::max(1, std::min(nThreads, static_cast<int>(points.size())));
 
     double mode = ccd->getLogLikelihood(); // TODO Remove
 
@@ -563,33 +619,72 @@ double CcdInterface::evaluateProfileModel(CyclicCoordinateDescent *ccd, Abstract
 
     for (int i = 1; i < nThreads; ++i) {
         ccdPool.push_back(ccd->clone());
+        if (ccdPool.back()) {
+            ccdPool.back()->setCoordinateStream(i);
+        }
     }
 
-    auto evaluate = [this, index, includePenalty](const double point,
-                            CyclicCoordinateDescent* ccd) {
+    // Each thread takes a contiguous piece of the sorted grid and walks it outwards from the mode,
+    // warm-starting every refit from its neighbour
+    std::vector<int> order(points.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&points](int lhs, int rhs) {
+        return points[lhs] < points[rhs];
+    });
+
+    const double x0 = x0s[index];
+    const int pivot = std::lower_bound(order.begin(), order.end(), x0, [&points](int lhs, double value) {
+        return points[lhs] < value;
+    }) - order.begin();
+
+    const int chunkSize = (static_cast<int>(order.size()) + nThreads - 1) / nThreads;
+
+    auto walk = [this, index, includePenalty, &points, &order, &values, &information](
+            CyclicCoordinateDescent* ccd, int from, int to, int step,
+            double startPoint, const std::vector<double>& startBeta) {
+
+        ccd->setBeta(startBeta);
+        double last = startPoint;
+
+        OptimizationProfile eval(*ccd, arguments, index, 0.0, 0.0, includePenalty);
+        for (int i = from; i != to; i += step) {
+            const int task = order[i];
+            values[task] = eval.objective(points[task]);
+            information[task].iterations = ccd->getIterationCount();
+            information[task].status = ccd->getUpdateReturnFlag();
+            information[task].start = last;
+            last = points[task];
+        }
+    };
 
-        OptimizationProfile eval(*ccd, arguments, index,
-                                 0.0, 0.0, includePenalty);
+    auto oneChunk = [&walk, &ccdPool, &x0s, x0, pivot, chunkSize, &order](int chunk) {
+        auto ccdTask = ccdPool[chunk];
+        const int begin = chunk * chunkSize;
+        const int end = std::min(begin + chunkSize, static_cast<int>(order.size()));
+        if (begin >= end) {
+            return;
+        }
 
-        return eval.objective(point);
+        if (pivot <= begin) {
+            walk(ccdTask, begin, end, 1, x0, x0s);
+        } else if (pivot >= end) {
+            walk(ccdTask, end - 1, begin - 1, -1, x0, x0s);
+        } else {
+            walk(ccdTask, pivot, end, 1, x0, x0s);
+            walk(ccdTask, pivot - 1, begin - 1, -1, x0, x0s);
+        }
     };
 
     if (nThreads == 1) {
-        for (int i = 0; i < points.size(); ++i) {
-            values[i] = evaluate(points[i], ccd);
-        }
+        oneChunk(0);
     } else {
         auto scheduler = TaskScheduler<boost::counting_iterator<int>>(
-            boost::make_counting_iterator(0), boost::make_counting_iterator(static_cast<int>(points.size())), nThreads);
-
-        auto oneTask = [&evaluate, &scheduler, &ccdPool, &points, &values](unsigned long task) {
-            values[task] = evaluate(points[task], ccdPool[scheduler.getThreadIndex(task)]);
-        };
+            boost::make_counting_iterator(0), boost::make_counting_iterator(nThreads), nThreads);
 
         // Run all tasks in parallel
         ccd->getProgressLogger().setConcurrent(true);
         ccd->getErrorHandler().setConcurrent(true);
-        scheduler.execute(oneTask);
+        scheduler.execute(oneChunk);
         ccd->getProgressLogger().setConcurrent(false);
         ccd->getErrorHandler().setConcurrent(false);
         ccd->getProgressLogger().flush();
@@ -658,6 +753,13 @@ double CcdInterface::fitModel(CyclicCoordinateDescent *ccd) {
 	struct timeval time1, time2;
 	gettimeofday(&time1, NULL);
 
+	ccd->setThreadCount((arguments.threads == -1) ?
+	    bsccs::thread::hardware_concurrency() : arguments.threads);
+
+	if (!arguments.subsampleProportions.empty()) {
+		fitSubsamples(ccd);
+	}
+
 	ccd->update(arguments.modeFinding);
 
 	gettimeofday(&time2, NULL);
@@ -666,6 +768,360 @@ double CcdInterface::fitModel(CyclicCoordinateDescent *ccd) {
 }
 
 
+double CcdInterface::fitOutcomes(
+		CyclicCoordinateDescent *ccd,
+		const std::vector<double>& outcomes,
+		int outcomeCount,
+		std::vector<double>& estimates,
+		std::vector<double>& logLikelihoods,
+		std::vector<UpdateReturnFlags>& returnFlags) {
+
+	struct timeval time1, time2;
+	gettimeofday(&time1, NULL);
+
+	const int K = ccd->getPredictionSize();
+	const int J = ccd->getBetaSize();
+
+	if (outcomes.size() != static_cast<size_t>(K) * outcomeCount) {
+		std::ostringstream stream;
+		stream << "Outcomes must provide " << K << " rows for each of " << outcomeCount << " outcomes";
+		error->throwError(stream);
+	}
+
+	estimates.resize(static_cast<size_t>(J) * outcomeCount);
+	logLikelihoods.resize(outcomeCount);
+	returnFlags.resize(outcomeCount);
+
+	int nThreads = (arguments.threads == -1) ?
+		bsccs::thread::hardware_concurrency() :
+		arguments.threads;
+	nThreads = std::max(1, std::min(nThreads, outcomeCount));
+
+	// Models with independent rows fit blocks of outcomes as lanes, sharing each pass over a column;
+	// otherwise every outcome gets its own model state over the shared design (and weights and prior of ccd)
+	const bool useLanes = ccd->getSupportsLanes(arguments.modeFinding);
+	const int maxLanes = 16;
+	const int lanes = useLanes ?
+		std::min(maxLanes, (outcomeCount + nThreads - 1) / nThreads) : 1;
+	const int blockCount = (outcomeCount + lanes - 1) / lanes;
+
+	std::vector<double> variances;
+	if (useLanes) {
+		variances = ccd->getHyperprior();
+		if (variances.empty()) {
+			variances.push_back(0.0); // Unused without a prior variance
+		}
+	}
+
+	auto scheduler = TaskScheduler<decltype(boost::make_counting_iterator(0))>(
+		boost::make_counting_iterator(0),
+		boost::make_counting_iterator(blockCount),
+		nThreads);
+
+	if (nThreads > 1) {
+		ccd->getProgressLogger().setConcurrent(true);
+	}
+
+	bool allocationError = false;
+	auto laneTask = [&](int block) {
+		const int first = block * lanes;
+		const int count = std::min(lanes, outcomeCount - first);
+
+		bsccs::unique_ptr<CyclicCoordinateDescent> ccdTask(ccd->clone());
+		if (!ccdTask) {
+			allocationError = true;
+			return;
+		}
+		ccdTask->setCoordinateStream(block + 1);
+		ccdTask->resetBeta();
+
+		std::vector<double> beta(static_cast<size_t>(J) * count);
+		for (int j = 0; j < J; ++j) {
+			std::fill(beta.begin() + j * count, beta.begin() + (j + 1) * count, ccdTask->getBeta(j));
+		}
+		std::vector<double> laneOutcomes(static_cast<size_t>(K) * count);
+		for (int k = 0; k < K; ++k) {
+			for (int l = 0; l < count; ++l) {
+				laneOutcomes[static_cast<size_t>(k) * count + l] = outcomes[static_cast<size_t>(first + l) * K + k];
+			}
+		}
+
+		std::vector<UpdateReturnFlags> laneFlags;
+		ccdTask->updateLanes(arguments.modeFinding, std::vector<double>(count, variances[0]), beta,
+			laneFlags, laneOutcomes.data());
+		std::vector<double> laneLogLikelihoods(count);
+		ccdTask->getLaneLogLikelihoods(laneLogLikelihoods);
+
+		for (int l = 0; l < count; ++l) {
+			const int m = first + l;
+			for (int j = 0; j < J; ++j) {
+				estimates[static_cast<size_t>(m) * J + j] = beta[j * count + l];
+			}
+			logLikelihoods[m] = laneLogLikelihoods[l];
+			returnFlags[m] = laneFlags[l];
+		}
+	};
+
+	auto outcomeTask = [&](int m) {
+		const std::vector<double> outcome(outcomes.begin() + static_cast<size_t>(m) * K,
+			outcomes.begin() + static_cast<size_t>(m + 1) * K);
+
+		bsccs::unique_ptr<CyclicCoordinateDescent> ccdTask(ccd->clone(outcome));
+		if (!ccdTask) {
+			allocationError = true;
+			return;
+		}
+		ccdTask->setCoordinateStream(m + 1);
+		ccdTask->resetBeta();
+		ccdTask->update(arguments.modeFinding);
+
+		for (int j = 0; j < J; ++j) {
+			estimates[static_cast<size_t>(m) * J + j] = ccdTask->getBeta(j);
+		}
+		logLikelihoods[m] = ccdTask->getLogLikelihood();
+		returnFlags[m] = ccdTask->getUpdateReturnFlag();
+	};
+
+	if (useLanes) {
+		scheduler.execute(laneTask);
+	} else {
+		scheduler.execute(outcomeTask);
+	}
+
+	if (nThreads > 1) {
+		ccd->getProgressLogger().setConcurrent(false);
+		ccd->getProgressLogger().flush();
+	}
+
+	if (allocationError) {
+		std::ostringstream stream;
+		stream << "Memory allocation error in multi-outcome fitting";
+		error->throwError(stream);
+	}
+
+	gettimeofday(&time2, NULL);
+
+	return calculateSeconds(time1, time2);
+}
+
+double CcdInterface::fitUnivariable(
+		CyclicCoordinateDescent *ccd,
+		const std::vector<int>& candidates,
+		double& baseLogLikelihood,
+		std::vector<double>& estimates,
+		std::vector<double>& standardErrors,
+		std::vector<double>& statistics,
+		std::vector<UpdateReturnFlags>& returnFlags) {
+
+	struct timeval time1, time2;
+	gettimeofday(&time1, NULL);
+
+	const int J = ccd->getBetaSize();
+	const int count = static_cast<int>(candidates.size());
+
+	std::vector<bool> fixed(count);
+	for (int i = 0; i < count; ++i) {
+		const int index = candidates[i];
+		if (index < 0 || index >= J) {
+			std::ostringstream stream;
+			stream << "Candidate covariate index " << index << " is out of range";
+			error->throwError(stream);
+		}
+		fixed[i] = ccd->getFixedBeta(index);
+	}
+
+	// Base model, candidates excluded
+	for (int index : candidates) {
+		ccd->setBeta(index, 0.0);
+		ccd->setFixedBeta(index, true);
+	}
+	ccd->update(arguments.modeFinding);
+	baseLogLikelihood = ccd->getLogLikelihood();
+
+	estimates.resize(count);
+	standardErrors.resize(count);
+	statistics.resize(count);
+	returnFlags.resize(count);
+
+	int nThreads = (arguments.threads == -1) ?
+		bsccs::thread::hardware_concurrency() :
+		arguments.threads;
+	nThreads = std::max(1, std::min(nThreads, count));
+
+	std::vector<CyclicCoordinateDescent*> ccdPool;
+	ccdPool.push_back(ccd);
+
+	for (int i = 1; i < nThreads; ++i) {
+		ccdPool.push_back(ccd->clone());
+		if (ccdPool.back()) {
+			ccdPool.back()->setCoordinateStream(i);
+		}
+	}
+
+	// Every clone starts at the base fit, so its linear predictor is the offset for each candidate
+	auto scheduler = TaskScheduler<decltype(boost::make_counting_iterator(0))>(
+		boost::make_counting_iterator(0),
+		boost::make_counting_iterator(count),
+		nThreads);
+
+	auto oneTask = [&](int i) {
+		auto ccdTask = ccdPool[scheduler.getThreadIndex(i)];
+		double estimate, hessian, logLikelihood;
+		returnFlags[i] = ccdTask->fitUnivariable(candidates[i], arguments.modeFinding,
+			estimate, hessian, logLikelihood);
+		estimates[i] = estimate;
+		standardErrors[i] = 1.0 / std::sqrt(hessian);
+		statistics[i] = 2.0 * (logLikelihood - baseLogLikelihood);
+	};
+
+	if (nThreads > 1) {
+		ccd->getProgressLogger().setConcurrent(true);
+		ccd->getErrorHandler().setConcurrent(true);
+	}
+	scheduler.execute(oneTask);
+	if (nThreads > 1) {
+		ccd->getProgressLogger().setConcurrent(false);
+		ccd->getErrorHandler().setConcurrent(false);
+		ccd->getProgressLogger().flush();
+		ccd->getErrorHandler().flush();
+	}
+
+	// Clean up copies
+	for (int i = 1; i < nThreads; ++i) {
+		delete ccdPool[i];
+	}
+
+	for (int i = 0; i < count; ++i) {
+		ccd->setFixedBeta(candidates[i], fixed[i]);
+	}
+
+	if (arguments.noiseLevel >= NOISY) {
+		std::ostringstream stream;
+		stream << "Fit " << count << " univariable extension(s) of the base model using "
+			<< nThreads << " thread(s)";
+		logger->writeLine(stream);
+	}
+
+	gettimeofday(&time2, NULL);
+
+	return calculateSeconds(time1, time2);
+}
+
+double CcdInterface::getScoreStatistics(
+		CyclicCoordinateDescent *ccd,
+		std::vector<int>& indices,
+		std::vector<double>& statistics,
+		int threads) {
+
+	struct timeval time1, time2;
+	gettimeofday(&time1, NULL);
+
+	const int J = ccd->getBetaSize();
+	const int count = static_cast<int>(indices.size());
+
+	for (int index : indices) {
+		if (index < 0 || index >= J) {
+			std::ostringstream stream;
+			stream << "Covariate index " << index << " is out of range";
+			error->throwError(stream);
+		}
+	}
+
+	std::vector<double> scores(count);
+
+	int nThreads = (threads == -1) ?
+		bsccs::thread::hardware_concurrency() : threads;
+	nThreads = std::max(1, std::min(nThreads, count));
+
+	// Gradient buffers live in the model, so each thread reads from its own copy of the fit
+	std::vector<CyclicCoordinateDescent*> ccdPool;
+	ccdPool.push_back(ccd);
+
+	for (int i = 1; i < nThreads; ++i) {
+		ccdPool.push_back(ccd->clone());
+		if (ccdPool.back()) {
+			ccdPool.back()->setCoordinateStream(i);
+		}
+	}
+
+	auto scheduler = TaskScheduler<decltype(boost::make_counting_iterator(0))>(
+		boost::make_counting_iterator(0),
+		boost::make_counting_iterator(count),
+		nThreads);
+
+	scheduler.execute([&](int i) {
+		scores[i] = ccdPool[scheduler.getThreadIndex(i)]->getScoreStatistic(indices[i]);
+	});
+
+	// Clean up copies
+	for (int i = 1; i < nThreads; ++i) {
+		delete ccdPool[i];
+	}
+
+	std::vector<int> order(count);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&scores](int lhs, int rhs) {
+		return scores[lhs] > scores[rhs];
+	});
+
+	std::vector<int> sortedIndices(count);
+	statistics.resize(count);
+	for (int i = 0; i < count; ++i) {
+		sortedIndices[i] = indices[order[i]];
+		statistics[i] = scores[order[i]];
+	}
+	indices.swap(sortedIndices);
+
+	gettimeofday(&time2, NULL);
+
+	return calculateSeconds(time1, time2);
+}
+
+void CcdInterface::fitSubsamples(CyclicCoordinateDescent *ccd) {
+
+	const AbstractModelData& modelData = ccd->getModelData();
+	const auto selectorType = getDefaultSelectorTypeOrOverride(
+		arguments.crossValidation.selectorType, modelData.getModelType());
+
+	ProportionSelector selector(0, modelData.getPidVectorSTL(), selectorType, arguments.seed,
+		logger, error);
+	selector.permute(); // Subsamples are nested
+
+	std::vector<double> originalWeights = ccd->getWeights();
+
+	// Subsample fits only need to be near the mode to serve as warm starts
+	ModeFindingArguments subsampleArguments = arguments.modeFinding;
+	subsampleArguments.tolerance = std::sqrt(arguments.modeFinding.tolerance);
+
+	std::vector<double> weights;
+	for (double proportion : arguments.subsampleProportions) {
+		if (proportion <= 0.0 || proportion >= 1.0) {
+			continue;
+		}
+		selector.setProportion(proportion);
+		selector.getWeights(0, weights);
+		if (!originalWeights.empty()) {
+			for (size_t k = 0; k < weights.size(); ++k) {
+				weights[k] *= originalWeights[k];
+			}
+		}
+
+		if (arguments.noiseLevel > SILENT) {
+			std::ostringstream stream;
+			stream << "Fitting to a subsample of proportion " << proportion;
+			logger->writeLine(stream);
+		}
+
+		ccd->setWeights(&weights[0]);
+		ccd->update(subsampleArguments);
+		if (ccd->getUpdateReturnFlag() != SUCCESS) {
+			ccd->resetBeta(); // Cold-start the next resolution
+		}
+	}
+
+	ccd->setWeights(originalWeights.empty() ? NULL : &originalWeights[0]);
+}
+
 SelectorType CcdInterface::getDefaultSelectorTypeOrOverride(SelectorType selectorType, ModelType modelType) {
 	if (selectorType == SelectorType::DEFAULT) {
 		selectorType = (modelType == ModelType::COX ||
@@ -748,7 +1204,9 @@ double CcdInterface::runCrossValidation(CyclicCoordinateDescent *ccd, AbstractMo
 			); // TODO ERROR HERE!  NOT ALL MODELS ARE SUBJECT
 
 	AbstractCrossValidationDriver* driver;
-	if (arguments.crossValidation.useAutoSearchCV) {
+	if (arguments.crossValidation.useApproximateLeaveOut) {
+		driver = new ApproximateLeaveOutCrossValidationDriver(arguments, logger, error);
+	} else if (arguments.crossValidation.useAutoSearchCV) {
 		if (arguments.useHierarchy) {
 			driver = new HierarchyAutoSearchCrossValidationDriver(*modelData, arguments, logger, error);
 		} else {
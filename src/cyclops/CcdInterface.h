@@ -34,11 +34,13 @@ struct CrossValidationArguments {
     // All options related to cross-validation go here
 	bool doCrossValidation;
 	bool useAutoSearchCV;
+	bool useApproximateLeaveOut;
 	double lowerLimit;
 	double upperLimit;
 	int fold;
 	int foldToCompute;
 	int gridSteps;
+	int gridLanes;
 	std::string cvFileName;
 	bool doFitAtOptimal;
     double startingVariance;
@@ -47,11 +49,13 @@ struct CrossValidationArguments {
     CrossValidationArguments() :
         doCrossValidation(false),
         useAutoSearchCV(false),
+        useApproximateLeaveOut(false),
         lowerLimit(0.01),
         upperLimit(20.0),
         fold(10),
         foldToCompute(10),
         gridSteps(10),
+        gridLanes(1),
         cvFileName("cv.txt"),
         doFitAtOptimal(true),
         startingVariance(-1),   // Use default from Genkins et al.
@@ -79,6 +83,14 @@ struct ModeFindingArguments {
 	double initialBound;
 	int maxBoundCount;
 	AlgorithmType algorithmType;
+	CoordinateSelectionType coordinateSelection;
+	double hybridFraction;
+	long seed; // Seeds the random coordinate schedule
+	int qnQ;
+	int newtonThreshold;
+	int gramThreshold;
+	int crossTermCacheSize; // Megabytes of strata cross terms kept for Fisher information
+	bool useSafeScreening;
 
 	ModeFindingArguments() :
 		tolerance(1E-6),
@@ -89,7 +101,15 @@ struct ModeFindingArguments {
 		swindleMultipler(10),
 		initialBound(2.0),
 		maxBoundCount(5),
-		algorithmType(AlgorithmType::CCD)
+		algorithmType(AlgorithmType::CCD),
+		coordinateSelection(CoordinateSelectionType::CYCLIC),
+		hybridFraction(0.1),
+		seed(-99),
+		qnQ(0),
+		newtonThreshold(0),
+		gramThreshold(-1),
+		crossTermCacheSize(1024),
+		useSafeScreening(false)
 	    { }
 };
 
@@ -124,10 +144,14 @@ struct CCDArguments {
 	// Needed for boot-strapping
 	bool doBootstrap;
 	bool reportRawEstimates;
+	ProfileVector rawEstimates; // Covariates whose draws are kept; empty keeps all
 	int replicates;
 	std::string bsFileName;
 	bool doPartial;
 
+	// Coarse-to-fine fitting: warm-start the full-data fit from fits to these proportions of the data
+	std::vector<double> subsampleProportions;
+
 	// Needed for model specification
 	int modelType;
 	std::string modelName;
@@ -164,6 +188,34 @@ public:
     double runFitMLEAtMode(
             CyclicCoordinateDescent* ccd);
 
+    // Fits each column of outcomes (rows x outcomeCount, column-major) against the design of ccd
+    double fitOutcomes(
+            CyclicCoordinateDescent *ccd,
+            const std::vector<double>& outcomes,
+            int outcomeCount,
+            std::vector<double>& estimates,
+            std::vector<double>& logLikelihoods,
+            std::vector<UpdateReturnFlags>& returnFlags);
+
+    // Fits the model with candidates (column indices) held at zero, then each candidate alone
+    // on top of that fit; statistics are likelihood-ratios against it
+    double fitUnivariable(
+            CyclicCoordinateDescent *ccd,
+            const std::vector<int>& candidates,
+            double& baseLogLikelihood,
+            std::vector<double>& estimates,
+            std::vector<double>& standardErrors,
+            std::vector<double>& statistics,
+            std::vector<UpdateReturnFlags>& returnFlags);
+
+    // Score statistics of columns (indices) against the current fit; both are returned sorted by
+    // decreasing statistic
+    double getScoreStatistics(
+            CyclicCoordinateDescent *ccd,
+            std::vector<int>& indices,
+            std::vector<double>& statistics,
+            int threads);
+
     double predictModel(
             CyclicCoordinateDescent *ccd,
             AbstractModelData *modelData);
@@ -184,6 +236,7 @@ public:
             const IdType covariate,
             const std::vector<double>& points,
             std::vector<double>& values,
+            std::vector<ProfilePointInformation>& information,
             int threads,
             bool includePenalty);
 
@@ -228,6 +281,8 @@ protected:
 
 	static SelectorType getDefaultSelectorTypeOrOverride(SelectorType selectorType, ModelType modelType);
 
+    void fitSubsamples(CyclicCoordinateDescent *ccd);
+
     CCDArguments arguments;
 
     virtual void initializeModelImpl(
@@ -15,6 +15,9 @@
 #include <time.h>
 #include <set>
 #include <list>
+#include <queue>
+#include <algorithm>
+#include <limits>
 
 //#include "Rcpp.h"
 
@@ -28,6 +31,46 @@ namespace bsccs {
 
 using namespace std; // TODO Bad form
 
+namespace {
+
+typedef Eigen::LDLT<CyclicCoordinateDescent::Matrix> Factorization;
+
+// z = L^{-1} P e_index for H = P^T L D L^T P; z is zero before the pivoted position, so only the tail is solved
+Eigen::VectorXd solveUnitColumn(const Factorization& factorization, int index, int* offset) {
+	const int n = static_cast<int>(factorization.rows());
+	Eigen::VectorXd unit = Eigen::VectorXd::Unit(n, index);
+	unit = factorization.transpositionsP() * unit;
+
+	Eigen::VectorXd::Index position;
+	unit.cwiseAbs().maxCoeff(&position);
+	const int m = n - static_cast<int>(position);
+
+	Eigen::VectorXd tail = Eigen::VectorXd::Unit(m, 0);
+	factorization.matrixLDLT().bottomRightCorner(m, m)
+		.template triangularView<Eigen::UnitLower>().solveInPlace(tail);
+	*offset = static_cast<int>(position);
+	return tail;
+}
+
+// Entry (i, j) of H^{-1} = P^T L^{-T} D^{-1} L^{-1} P, without forming the inverse
+double getInverseEntry(const Factorization& factorization, int i, int j) {
+	int offsetI, offsetJ;
+	const Eigen::VectorXd zi = solveUnitColumn(factorization, i, &offsetI);
+	const Eigen::VectorXd zj = (i == j) ? zi : solveUnitColumn(factorization, j, &offsetJ);
+	if (i == j) {
+		offsetJ = offsetI;
+	}
+
+	const Eigen::VectorXd& d = factorization.vectorD();
+	double entry = 0.0;
+	for (int k = std::max(offsetI, offsetJ); k < d.size(); ++k) {
+		entry += zi(k - offsetI) * zj(k - offsetJ) / d(k);
+	}
+	return entry;
+}
+
+} // namespace
+
 CyclicCoordinateDescent::CyclicCoordinateDescent(
 			//ModelData* reader,
 			const AbstractModelData& reader,
@@ -53,6 +96,12 @@ CyclicCoordinateDescent::CyclicCoordinateDescent(
 	likelihoodCount = 0;
 	noiseLevel = NOISY;
 	initialBound = 2.0;
+	coordinateSelection = CoordinateSelectionType::CYCLIC;
+	hybridFraction = 0.1;
+	coordinateSeed = -99;
+	coordinateStream = 0;
+	newtonThreshold = 0;
+	threadCount = 1;
 
 	init(hXI.getHasOffsetCovariate());
 }
@@ -61,13 +110,27 @@ CyclicCoordinateDescent* CyclicCoordinateDescent::clone() {
 	return new (std::nothrow) CyclicCoordinateDescent(*this);
 }
 
+CyclicCoordinateDescent* CyclicCoordinateDescent::clone(const std::vector<double>& outcome) {
+	if (outcome.size() != static_cast<size_t>(K)) {
+		std::ostringstream stream;
+		stream << "Outcome length " << outcome.size() << " does not match " << K << " rows";
+		error->throwError(stream);
+	}
+	return new (std::nothrow) CyclicCoordinateDescent(*this, modelSpecifics.clone(outcome));
+}
+
 //template <typename T>
 //struct GetType<T>;
 
 CyclicCoordinateDescent::CyclicCoordinateDescent(const CyclicCoordinateDescent& copy)
+	: CyclicCoordinateDescent(copy, copy.modelSpecifics.clone()) { // deep copy
+	// Do nothing
+}
+
+CyclicCoordinateDescent::CyclicCoordinateDescent(const CyclicCoordinateDescent& copy,
+		AbstractModelSpecifics* specifics)
 	: privateModelSpecifics(
-			bsccs::unique_ptr<AbstractModelSpecifics>(
-				copy.modelSpecifics.clone())), // deep copy
+			bsccs::unique_ptr<AbstractModelSpecifics>(specifics)),
 	  modelSpecifics(*privateModelSpecifics),
       jointPrior(copy.jointPrior), // swallow
       hXI(copy.hXI), // swallow
@@ -88,6 +151,13 @@ CyclicCoordinateDescent::CyclicCoordinateDescent(const CyclicCoordinateDescent&
 	likelihoodCount = 0;
 	noiseLevel = copy.noiseLevel;
 	initialBound = copy.initialBound;
+	coordinateSelection = copy.coordinateSelection;
+	hybridFraction = copy.hybridFraction;
+	coordinatePrng = copy.coordinatePrng;
+	coordinateSeed = copy.coordinateSeed;
+	coordinateStream = copy.coordinateStream;
+	newtonThreshold = copy.newtonThreshold;
+	threadCount = 1; // Clones already run concurrently
 
 	init(hXI.getHasOffsetCovariate());
 
@@ -176,10 +246,24 @@ void CyclicCoordinateDescent::setPrior(priors::JointPriorPtr newPrior) {
     jointPrior = newPrior;
 }
 
+bool CyclicCoordinateDescent::setPrivatePrior() {
+    auto copy = jointPrior->clone();
+    if (copy == nullptr) {
+        return false;
+    }
+    jointPrior = priors::JointPriorPtr(copy);
+    return true;
+}
+
 void CyclicCoordinateDescent::setInitialBound(double bound) {
     initialBound = bound;
 }
 
+void CyclicCoordinateDescent::setThreadCount(int threads) {
+    threadCount = std::max(1, threads);
+    modelSpecifics.setThreadCount(threadCount);
+}
+
 void CyclicCoordinateDescent::resetBounds() {
 	for (int j = 0; j < J; j++) {
 		hDelta[j] = initialBound;
@@ -196,6 +280,7 @@ void CyclicCoordinateDescent::init(bool offset) {
 // 	hXBetaSave.resize(K, static_cast<double>(0.0));
 
 	fixBeta.resize(J, false);
+	coordinateScores.resize(J, static_cast<double>(0.0));
 	hWeights.resize(0);
 
 	useCrossValidation = false;
@@ -224,6 +309,10 @@ void CyclicCoordinateDescent::init(bool offset) {
 			NULL
 		//	hY
 			);
+
+	if (!hXI.getRowMultiplicity().empty()) { // Aggregated rows always carry weights
+		setWeights(NULL);
+	}
 }
 
 int CyclicCoordinateDescent::getAlignedLength(int N) {
@@ -231,6 +320,15 @@ int CyclicCoordinateDescent::getAlignedLength(int N) {
 }
 
 void CyclicCoordinateDescent::computeNEvents() {
+	const auto& multiplicity = hXI.getRowMultiplicity();
+	if (!multiplicity.empty() && hWeights.size() > 0) {
+		std::vector<double> weights(hWeights);
+		for (int i = 0; i < K; ++i) {
+			weights[i] *= multiplicity[i];
+		}
+		modelSpecifics.setWeights(weights.data(), useCrossValidation);
+		return;
+	}
 	modelSpecifics.setWeights(
 		hWeights.size() > 0 ? hWeights.data() : nullptr,
 		useCrossValidation);
@@ -334,6 +432,15 @@ double CyclicCoordinateDescent::getNewPredictiveLogLikelihood(double* weights) {
 
     getDenominators();
 
+    const auto& multiplicity = hXI.getRowMultiplicity();
+    if (!multiplicity.empty() && weights != nullptr) {
+        std::vector<double> rowWeights(weights, weights + K);
+        for (int i = 0; i < K; ++i) {
+            rowWeights[i] *= multiplicity[i];
+        }
+        return modelSpecifics.getPredictiveLogLikelihood(rowWeights.data());
+    }
+
     return modelSpecifics.getPredictiveLogLikelihood(weights); // TODO Pass double
 }
 
@@ -474,7 +581,12 @@ std::vector<double> CyclicCoordinateDescent::getWeights() {
 
 void CyclicCoordinateDescent::setWeights(double* iWeights) {
 
-	if (iWeights == NULL) {
+	if (iWeights == NULL && !hXI.getRowMultiplicity().empty()) {
+		hWeights.assign(K, 1.0); // Row multiplicities are applied in computeNEvents()
+		useCrossValidation = true;
+		validWeights = false;
+		sufficientStatisticsKnown = false;
+	} else if (iWeights == NULL) {
 		if (hWeights.size() != 0) {
 			hWeights.resize(0);
 		}
@@ -553,9 +665,26 @@ void CyclicCoordinateDescent::update(const ModeFindingArguments& arguments) {
 	const auto epsilon = arguments.tolerance;
 	const int maxCount = arguments.maxBoundCount;
 	const auto algorthmType = arguments.algorithmType;
-	const int qnQ = 0;
+	const int qnQ = arguments.qnQ;
 
 	initialBound = arguments.initialBound;
+	coordinateSelection = arguments.coordinateSelection;
+	hybridFraction = arguments.hybridFraction;
+	if (arguments.seed != coordinateSeed) {
+		seedCoordinatePrng(arguments.seed);
+	}
+	newtonThreshold = arguments.newtonThreshold;
+	modelSpecifics.setGramThreshold(arguments.gramThreshold);
+	modelSpecifics.setCrossTermCacheSize(static_cast<size_t>(arguments.crossTermCacheSize) << 20);
+
+	const auto merged = mergeDuplicateCovariates();
+
+	if (arguments.useSafeScreening && modelSpecifics.getSupportsSafeScreening()) {
+		screeningExcluded = fixBeta;
+		screenedOut.assign(J, false);
+		screeningNorms.clear();
+		safeScreenCovariates();
+	}
 
 	int count = 0;
 	bool done = false;
@@ -575,6 +704,138 @@ void CyclicCoordinateDescent::update(const ModeFindingArguments& arguments) {
 	        done = true;
 	    }
 	}
+
+	for (int j = 0; j < static_cast<int>(screenedOut.size()); ++j) {
+		if (screenedOut[j]) {
+			fixBeta[j] = false;
+		}
+	}
+	screenedOut.clear();
+
+	splitDuplicateCovariates(merged);
+}
+
+int CyclicCoordinateDescent::safeScreenCovariates() {
+
+	// Gap Safe rule (Ndiaye et al., 2017): with per-row loss curvature bounded by L_k, the dual optimum lies
+	// within sqrt(2 * gap) of any feasible dual point in the 1/L metric, so |x_j' theta| + sqrt(2 * gap * sum L_k x_kj^2) < lambda_j
+	// proves beta_j = 0 at the mode
+	checkAllLazyFlags();
+
+	DoubleVector gradient;
+	modelSpecifics.computeGradient(gradient, screeningExcluded, useCrossValidation, threadCount);
+
+	std::vector<int> unpenalized;
+	bool hasPenalized = false;
+	for (int j = 0; j < J; ++j) {
+		if (!screeningExcluded[j]) {
+			if (!jointPrior->getSupportsSafeScreening(j)) {
+				return 0;
+			}
+			if (jointPrior->getKktBoundary(j) > 0.0) {
+				hasPenalized = true;
+			} else {
+				unpenalized.push_back(j);
+			}
+		}
+	}
+
+	// Dual feasibility needs the dual point orthogonal to the unpenalized columns
+	if (!hasPenalized || !modelSpecifics.projectDualPoint(unpenalized, gradient, useCrossValidation)) {
+		return 0;
+	}
+
+	double scale = 1.0;
+	double penalty = 0.0;
+	for (int j = 0; j < J; ++j) {
+		if (!screeningExcluded[j]) {
+			const double lambda = jointPrior->getKktBoundary(j);
+			if (lambda > 0.0) {
+				scale = std::max(scale, std::abs(gradient[j]) / lambda);
+				penalty += lambda * std::abs(hBeta[j]);
+			}
+		}
+	}
+
+	if (screeningNorms.size() != static_cast<size_t>(J)) {
+		modelSpecifics.computeCurvatureNorms(screeningNorms, useCrossValidation);
+	}
+
+	double gap = -getLogLikelihood() + penalty - modelSpecifics.getDualObjective(scale, useCrossValidation);
+	if (!std::isfinite(gap)) {
+		return 0; // Dual point left the domain of the conjugate
+	}
+	gap = std::max(0.0, gap);
+	const double radius = std::sqrt(2.0 * gap);
+
+	int count = 0;
+	bool moved = false;
+	for (int j = 0; j < J; ++j) {
+		if (!screeningExcluded[j] && !screenedOut[j]) {
+			const double lambda = jointPrior->getKktBoundary(j);
+			if (lambda > 0.0 &&
+				std::abs(gradient[j]) / scale + radius * std::sqrt(screeningNorms[j]) < lambda) {
+				screenedOut[j] = true;
+				fixBeta[j] = true;
+				if (hBeta[j] != 0.0) {
+					hBeta[j] = 0.0;
+					moved = true;
+				}
+				++count;
+			}
+		}
+	}
+
+	if (moved) {
+		modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
+		computeRemainingStatistics(true, 0);
+		sufficientStatisticsKnown = true;
+	}
+
+	if (count > 0 && noiseLevel > QUIET) {
+		std::ostringstream stream;
+		stream << "Screened out " << count << " covariate(s) at duality gap " << gap;
+		logger->writeLine(stream);
+	}
+	return count;
+}
+
+std::vector<int> CyclicCoordinateDescent::mergeDuplicateCovariates() {
+
+	// Identical columns leave xBeta unchanged when their coefficients are pooled
+	std::vector<int> merged;
+	for (int j = 0; j < J; ++j) {
+		const int representative = hXI.getDuplicateOf(j);
+		if (representative != -1 && !fixBeta[j] && !fixBeta[representative] &&
+			jointPrior->getCanMerge(representative, j)) {
+			hBeta[representative] += hBeta[j];
+			hBeta[j] = 0.0;
+			fixBeta[j] = true;
+			merged.push_back(j);
+		}
+	}
+
+	if (merged.size() > 0 && noiseLevel > QUIET) {
+		std::ostringstream stream;
+		stream << "Fitting " << merged.size() << " duplicate covariate(s) through their representatives";
+		logger->writeLine(stream);
+	}
+	return merged;
+}
+
+void CyclicCoordinateDescent::splitDuplicateCovariates(const std::vector<int>& merged) {
+
+	std::map<int, int> groupSize;
+	for (auto j : merged) {
+		groupSize[hXI.getDuplicateOf(j)] += 1;
+	}
+	for (auto& group : groupSize) {
+		hBeta[group.first] /= static_cast<double>(group.second + 1);
+	}
+	for (auto j : merged) {
+		hBeta[j] = hBeta[hXI.getDuplicateOf(j)];
+		fixBeta[j] = false;
+	}
 }
 
 typedef std::tuple<
@@ -583,6 +844,122 @@ typedef std::tuple<
 	bool    // force active
 > ScoreTuple;
 
+bool CyclicCoordinateDescent::getSupportsLanes(const ModeFindingArguments& arguments) const {
+	return modelSpecifics.getSupportsLanes() && jointPrior->getSupportsLanes() &&
+		arguments.convergenceType == GRADIENT &&
+		arguments.algorithmType == AlgorithmType::CCD &&
+		arguments.qnQ == 0;
+}
+
+void CyclicCoordinateDescent::updateLanes(const ModeFindingArguments& arguments,
+		const std::vector<double>& variances,
+		std::vector<double>& beta,
+		std::vector<UpdateReturnFlags>& returnFlags,
+		const double* outcomes) {
+
+	if (!getSupportsLanes(arguments)) {
+		std::ostringstream stream;
+		stream << "Lanes are not supported for this model, prior or mode-finding algorithm";
+		error->throwError(stream);
+	}
+
+	const int lanes = static_cast<int>(variances.size());
+	if (beta.size() != static_cast<size_t>(J) * lanes) {
+		std::ostringstream stream;
+		stream << "Lane starting values must have " << J << " x " << lanes << " entries";
+		error->throwError(stream);
+	}
+
+	checkAllLazyFlags(); // Weights and fixed terms are shared by all lanes
+	modelSpecifics.initializeLanes(lanes, beta.data(), outcomes, useCrossValidation);
+
+	std::vector<double> bound(J * lanes, arguments.initialBound);
+	std::vector<double> gradient(lanes);
+	std::vector<double> hessian(lanes);
+	std::vector<double> delta(lanes);
+	std::vector<double> lastObjective(lanes);
+	std::vector<double> objective(lanes);
+	std::vector<bool> active(lanes, true);
+
+	returnFlags.assign(lanes, SUCCESS);
+	modelSpecifics.getGradientObjectiveLanes(lastObjective.data(), useCrossValidation);
+
+	int remaining = lanes;
+	for (int iteration = 1; remaining > 0; ++iteration) {
+
+		for (int index = 0; index < J; ++index) {
+			if (fixBeta[index]) {
+				continue;
+			}
+
+			modelSpecifics.computeGradientAndHessianLanes(index, gradient.data(), hessian.data(),
+				useCrossValidation);
+			for (int l = 0; l < lanes; ++l) {
+				if (hessian[l] < 0.0) {
+					gradient[l] = 0.0;
+					hessian[l] = 0.0;
+				}
+			}
+
+			double* laneBeta = &beta[index * lanes];
+			jointPrior->getDeltaLanes(gradient.data(), hessian.data(), laneBeta, index,
+				variances.data(), lanes, delta.data());
+
+			// As applyBounds(), with one trust region per lane
+			bool changed = false;
+			for (int l = 0; l < lanes; ++l) {
+				if (!active[l]) {
+					delta[l] = 0.0;
+					continue;
+				}
+				double& laneBound = bound[index * lanes + l];
+				if (delta[l] < -laneBound) {
+					delta[l] = -laneBound;
+				} else if (delta[l] > laneBound) {
+					delta[l] = laneBound;
+				}
+				laneBound = std::max(std::max(std::abs(delta[l]) * 2, laneBound / 2), 1E-3);
+
+				if (delta[l] != 0.0) {
+					laneBeta[l] += delta[l];
+					changed = true;
+				}
+			}
+
+			if (changed) {
+				modelSpecifics.updateXBetaLanes(index, delta.data());
+			}
+		}
+
+		modelSpecifics.getGradientObjectiveLanes(objective.data(), useCrossValidation);
+		for (int l = 0; l < lanes; ++l) {
+			if (!active[l]) {
+				continue;
+			}
+			bool done = true;
+			if (objective[l] != objective[l]) {
+				returnFlags[l] = ILLCONDITIONED;
+			} else if (arguments.tolerance > 0 &&
+				computeConvergenceCriterion(objective[l], lastObjective[l]) < arguments.tolerance) {
+				returnFlags[l] = SUCCESS;
+			} else if (iteration == arguments.maxIterations) {
+				returnFlags[l] = MAX_ITERATIONS;
+			} else {
+				done = false;
+			}
+			lastObjective[l] = objective[l];
+			if (done) {
+				active[l] = false;
+				--remaining;
+			}
+		}
+	}
+}
+
+void CyclicCoordinateDescent::getLaneLogLikelihoods(std::vector<double>& logLikelihoods) {
+	modelSpecifics.getLogLikelihoodLanes(logLikelihoods.data(), useCrossValidation);
+}
+
 template <typename Iterator>
 void CyclicCoordinateDescent::findMode(Iterator begin, Iterator end,
 		const int maxIterations, const int convergenceType, const double epsilon,
@@ -602,7 +979,7 @@ void CyclicCoordinateDescent::kktSwindle(const ModeFindingArguments& arguments)
 	const auto convergenceType = arguments.convergenceType;
 	const auto epsilon = arguments.tolerance;
 	const auto algorithmType = arguments.algorithmType;
-	const int qnQ = 0;
+	const int qnQ = arguments.qnQ;
 
 	// Make sure internal state is up-to-date
 	checkAllLazyFlags();
@@ -623,7 +1000,8 @@ void CyclicCoordinateDescent::kktSwindle(const ModeFindingArguments& arguments)
 			excludeSet.push_back(index);
 		} else {
 			if (index == intercept || // Always place intercept into active set
-                !jointPrior->getSupportsKktSwindle(index)) {
+                !jointPrior->getSupportsKktSwindle(index) ||
+                hBeta[index] != 0.0) { // Warm starts keep their active set
 // 				activeSet.push_back(index);
 				activeSet.push_back(std::make_tuple(index, 0.0, true));
 			} else {
@@ -632,6 +1010,17 @@ void CyclicCoordinateDescent::kktSwindle(const ModeFindingArguments& arguments)
 		}
 	}
 
+	auto dropScreened = [this,&activeSet,&inactiveSet] {
+		if (!screenedOut.empty()) {
+			auto screened = [this] (const ScoreTuple& score) {
+				return screenedOut[std::get<0>(score)];
+			};
+			activeSet.remove_if(screened);
+			inactiveSet.remove_if(screened);
+		}
+	};
+	dropScreened();
+
 	bool done = false;
 	int swindleIterationCount = 1;
 
@@ -672,6 +1061,11 @@ void CyclicCoordinateDescent::kktSwindle(const ModeFindingArguments& arguments)
 			logger->writeLine(stream);
 		}
 
+		if (!screenedOut.empty() && lastReturnFlag == SUCCESS) {
+			safeScreenCovariates(); // Before checking KKT conditions on the inactive set
+			dropScreened();
+		}
+
 		if (inactiveSet.size() == 0 || lastReturnFlag != SUCCESS) { // Computed global mode, nothing more to do, or failed
 
 			done = true;
@@ -828,12 +1222,12 @@ bool CyclicCoordinateDescent::performCheckConvergence(int convergenceType,
     } // Necessary to call getObjFxn or computeZO before getLogLikelihood,
     // since these copy over XBeta
 
-    double thisLogLikelihood = getLogLikelihood();
-    double thisLogPrior = getLogPrior();
-    double thisLogPost = thisLogLikelihood + thisLogPrior;
-
     std::ostringstream stream;
     if (noiseLevel > QUIET) {
+        // Only reported, so left unevaluated otherwise (it forces lazily updated xBeta to be refreshed)
+        double thisLogLikelihood = getLogLikelihood();
+        double thisLogPrior = getLogPrior();
+        double thisLogPost = thisLogLikelihood + thisLogPrior;
         // stream << "\n";
         // printVector(&hBeta[0], J, stream);
         stream << "\n";
@@ -915,6 +1309,38 @@ void CyclicCoordinateDescent::findMode(
 		saveXBeta();
 	}
 
+	if (algorithmType == AlgorithmType::CCD && newtonThreshold > 0) {
+	    const auto free = std::count(fixBeta.begin(), fixBeta.end(), false);
+	    if (free <= newtonThreshold && getCanUseNewton(fixBeta)) {
+	        algorithmType = AlgorithmType::NEWTON;
+	    }
+	}
+
+	if (algorithmType == AlgorithmType::NEWTON && !getCanUseNewton(fixBeta)) {
+	    if (noiseLevel > QUIET) {
+	        std::ostringstream stream;
+	        stream << "Dense Newton steps require smooth priors and no fold weights; using CCD";
+	        logger->writeLine(stream);
+	    }
+	    algorithmType = AlgorithmType::CCD;
+	}
+
+	if (algorithmType == AlgorithmType::IRLS &&
+	    !modelSpecifics.setQuadraticApproximation(false, useCrossValidation)) {
+	    if (noiseLevel > QUIET) {
+	        std::ostringstream stream;
+	        stream << "Quadratic-approximation steps require a non-quadratic model with independent rows; using CCD";
+	        logger->writeLine(stream);
+	    }
+	    algorithmType = AlgorithmType::CCD;
+	}
+
+	if (algorithmType == AlgorithmType::FISTA) {
+	    fistaPrevious = hBeta;
+	    fistaMomentum = 1.0;
+	    fistaStep = 1.0;
+	}
+
 	std::vector<double> allDelta;
     double lastLogPosterior; // = getLogLikelihood() + getLogPrior();
 
@@ -924,7 +1350,14 @@ void CyclicCoordinateDescent::findMode(
 	    lastLogPosterior = -10E10;
 	}
 
-	auto cycle = [this,&iteration,algorithmType,&allDelta] {
+	std::vector<int> order;
+
+	auto cycle = [this,&iteration,algorithmType,epsilon,&allDelta,&order] {
+
+	    const int screeningInterval = 10;
+	    if (!screenedOut.empty() && iteration > 0 && iteration % screeningInterval == 0) {
+	        safeScreenCovariates();
+	    }
 
 	    auto log = [this](const int index) {
 	        if ( (noiseLevel > QUIET) && ((index+1) % 100 == 0)) {
@@ -966,7 +1399,19 @@ void CyclicCoordinateDescent::findMode(
             sufficientStatisticsKnown = true;
 
 
-	    } else {
+	    } else if (algorithmType == AlgorithmType::NEWTON) {
+
+	        newtonUpdateAllBeta(fixBeta);
+
+	    } else if (algorithmType == AlgorithmType::FISTA) {
+
+	        fistaUpdateAllBeta(fixBeta);
+
+	    } else if (algorithmType == AlgorithmType::IRLS) {
+
+	        irlsUpdateAllBeta(fixBeta, epsilon);
+
+	    } else if (coordinateSelection == CoordinateSelectionType::CYCLIC) {
 
 	        // Do a complete cycle in serial
 	        for(int index = 0; index < J; index++) {
@@ -982,6 +1427,26 @@ void CyclicCoordinateDescent::findMode(
 
 	            log(index);
 	        }
+	    } else if (coordinateSelection == CoordinateSelectionType::GREEDY) {
+
+	        greedyUpdateAllBeta(fixBeta);
+
+	    } else {
+
+	        // Do a complete cycle in serial, visiting coordinates in scheduled order
+	        scheduleCoordinates(order);
+	        for (size_t position = 0; position < order.size(); ++position) {
+	            const int index = order[position];
+
+	            double delta = ccdUpdateBeta(index);
+	            delta = applyBounds(delta, index);
+	            if (delta != 0.0) {
+	                sufficientStatisticsKnown = false;
+	                updateSufficientStatistics(delta, index);
+	            }
+
+	            log(position);
+	        }
 	    }
 	    iteration++;
 	};
@@ -1017,9 +1482,7 @@ void CyclicCoordinateDescent::findMode(
                    return done;
                };
 
-	qnQ = 0;
-
-	if (qnQ > 0) { // Use quasi-Newton
+	if (qnQ > 0) { // Use quasi-Newton acceleration (Zhou, Alexander and Lange, 2011)
 	    using namespace Eigen;
 
 	    Eigen::MatrixXd secantsU(J, qnQ);
@@ -1052,116 +1515,84 @@ void CyclicCoordinateDescent::findMode(
 	        }
 	    }
 
-	    // 	    std::cerr << secantsU << std::endl << std::endl;
-	    // 	    std::cerr << secantsV << std::endl;
-
 	    int newestSecant = qnQ - 1;
-	    int previousSecant = newestSecant - 1;
+
+	    // Zhang-Oles convergence owns hXBetaSave between checks
+	    const bool restoreSavedXBeta = convergenceType < ZHANG_OLES;
+
+	    int acceptCount = 0;
+	    int revertCount = 0;
 
 	    while (!done) {
 
 	        // 2 cycles for each QN step
 	        x = Map<const VectorXd>(hBeta.data(), J); // Make copy
 	        cycle();
-	        // 	        done = check();
-	        // 	        if (done) {
-	        // 	            std::cerr << "break A" << std::endl;
-	        // 	            break;
-	        // 	        }
 
 	        secantsU.col(newestSecant) = Map<const VectorXd>(hBeta.data(), J) - x;
 
-	        VectorXd Fx = Map<const VectorXd>(hBeta.data(), J); // TODO Can remove?
+	        const VectorXd Fx = Map<const VectorXd>(hBeta.data(), J);
 
 	        x = Map<const VectorXd>(hBeta.data(), J);
 	        cycle();
-	        // 	        done = check();
-	        // 	        if (done) {
-	        // 	            std::cerr << "break B" << std::endl;
-	        // 	            break;
-	        // 	        }
 
 	        secantsV.col(newestSecant) = Map<const VectorXd>(hBeta.data(), J) - x;
 
 	        // Do QN step here
+	        const MatrixXd M = secantsU.transpose() * (secantsU - secantsV);
+	        const FullPivLU<MatrixXd> luM(M);
 
-	        //             MatrixXd UtU = secantsU.transpose() * secantsU;
-	        //             MatrixXd UtV = secantsU.transpose() * secantsV;
-	        //             MatrixXd M = UtU - UtV;
-
-	        auto M = secantsU.transpose() * (secantsU - secantsV);
-
-	        auto Minv = M.inverse();
-
-	        auto A = secantsU.transpose() * secantsU.col(newestSecant);
-	        auto B = Minv * A;
-	        auto C = secantsV * B;
+	        if (luM.isInvertible()) {
 
-	        // MatrixXd A = secantsV * Minv;
-	        // MatrixXd B = A * secantsU.transpose();
-	        // MatrixXd C = B * secantsV.col(newestSecant); // - (x - Fx)
-	        // MatrixXd C = B * secantsU.col(newestSecant); // TODO Can remove?
+	            const VectorXd A = secantsU.transpose() * secantsU.col(newestSecant);
+	            VectorXd xqn = Fx + secantsV * luM.solve(A);
 
-	        //     VectorXd xqn = Map<const VectorXd>(hBeta.data(), J) + C;
-	        VectorXd xqn = Fx + C; // TODO Can remove?
-
-	        // Save CCD solution
-	        x = Map<const VectorXd>(hBeta.data(), J);
-	        double ccdObjective = getLogLikelihood() + getLogPrior();
-	        // double savedLastObjFunc = lastObjFunc;
-
-	        Map<VectorXd>(hBeta.data(), J) = xqn; // Set QN solution
-	        //             for (int j = 0; j < J; ++j) {
-	        //                 if (sign(hBeta[j]) == xqn(j)) {
-	        //                     hBeta[j] = xqn(j);
-	        //                 } else {
-	        //                     hBeta[j] = 0.0;
-	        //                 }
-	        //             }
-
-	        // xBetaKnown = false;
-	        // checkAllLazyFlags();
-	        modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
-
-
-	        //             done = check();
-	        //             if (done) {
-	        //                 std::cerr << "break B" << std::endl;
-	        //                 break;
-	        //             }
+	            for (int j = 0; j < J; ++j) {
+	                if (fixBeta[j]) {
+	                    xqn(j) = hBeta[j];
+	                }
+	            }
 
-	        double qnObjective = getLogLikelihood() + getLogPrior();
+	            // Save CCD solution
+	            x = Map<const VectorXd>(hBeta.data(), J);
+	            const double ccdObjective = getLogLikelihood() + getLogPrior();
+	            if (restoreSavedXBeta) {
+	                modelSpecifics.saveXBeta();
+	            }
 
-	        if (ccdObjective > qnObjective) { // Revert
-	            Map<VectorXd>(hBeta.data(), J) = x; // Set CCD solution
+	            Map<VectorXd>(hBeta.data(), J) = xqn; // Set QN solution
 	            modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
-	            // xBetaKnown = false;
-	            // checkAllLazyFlags();
+	            computeRemainingStatistics(true, 0);
+	            sufficientStatisticsKnown = true;
 
-	            double ccd2Objective = getLogLikelihood() + getLogPrior();
+	            const double qnObjective = getLogLikelihood() + getLogPrior();
 
-	            if (ccdObjective != ccd2Objective) {
-	                std::cerr << "Poor revert: " << ccdObjective << " != " << ccd2Objective << " diff: "<< (ccdObjective - ccd2Objective) << std::endl;
+	            if (!(qnObjective >= ccdObjective)) { // Revert to keep ascent monotone; also catches NaN
+	                Map<VectorXd>(hBeta.data(), J) = x; // Set CCD solution
+	                if (restoreSavedXBeta) {
+	                    modelSpecifics.restoreXBeta();
+	                } else {
+	                    modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
+	                }
+	                computeRemainingStatistics(true, 0);
+	                sufficientStatisticsKnown = true;
+	                ++revertCount;
+	            } else {
+	                ++acceptCount;
 	            }
-	            // lastObjFunc = savedLastObjFunc;
-	            std::cerr << "revert" << std::endl;
-	        } else {
-	            std::cerr << "accept" << std::endl;
-	            //                 done = check();
-	            //                 if (done) {
-	            //                     std::cerr << "break C" << std::endl;
-	            //                     break;
-	            //                 }
 	        }
 
 	        done = check();
 
-	        // lastObjFunc = getLogLikelihood() + getLogPrior();
-
 	        // Get ready for next secant-pair
-	        previousSecant = newestSecant;
 	        newestSecant = (newestSecant + 1) % qnQ;
 	    }
+
+	    if (noiseLevel > QUIET) {
+	        std::ostringstream stream;
+	        stream << "Quasi-Newton steps accepted: " << acceptCount << ", reverted: " << revertCount;
+	        logger->writeLine(stream);
+	    }
     } else { // No QN
         while (!done) {
             cycle();
@@ -1209,6 +1640,101 @@ double CyclicCoordinateDescent::getHessianDiagonal(int index) {
 	return g_d2;
 }
 
+double CyclicCoordinateDescent::getLogLikelihoodGradient(int index) {
+
+	checkAllLazyFlags();
+	double g_d1, g_d2;
+
+	computeNumeratorForGradient(index);
+	computeGradientAndHessian(index, &g_d1, &g_d2);
+
+	return -g_d1; // Model gradients are of the negative log-likelihood
+}
+
+double CyclicCoordinateDescent::getScoreStatistic(int index) {
+
+	checkAllLazyFlags();
+	double g_d1, g_d2;
+
+	computeNumeratorForGradient(index);
+	computeGradientAndHessian(index, &g_d1, &g_d2);
+
+	return (g_d2 > 0.0) ? g_d1 * g_d1 / g_d2 : 0.0;
+}
+
+UpdateReturnFlags CyclicCoordinateDescent::fitUnivariable(int index, const ModeFindingArguments& arguments,
+		double& estimate, double& hessian, double& logLikelihood) {
+
+	checkAllLazyFlags();
+
+	const double start = hBeta[index];
+	double bound = arguments.initialBound;
+	logLikelihood = getLogLikelihood();
+
+	UpdateReturnFlags flag = MAX_ITERATIONS;
+	for (int iteration = 0; iteration < arguments.maxIterations; ++iteration) {
+
+		double gradient, curvature;
+		computeNumeratorForGradient(index);
+		computeGradientAndHessian(index, &gradient, &curvature);
+
+		if (!(curvature > 0.0)) {
+			flag = ILLCONDITIONED;
+			break;
+		}
+
+		// Bounded as in applyBounds(); unbounded steps lose precision in the running denominators
+		double delta = -gradient / curvature;
+		delta = std::max(-bound, std::min(delta, bound));
+		bound = std::max(std::max(std::abs(delta) * 2, bound / 2), 1E-3);
+
+		// Step-halve until the likelihood does not decrease
+		double newLogLikelihood = 0.0;
+		for (int halving = 0; ; ++halving) {
+			updateSufficientStatistics(delta, index);
+			newLogLikelihood = getLogLikelihood();
+			if (newLogLikelihood >= logLikelihood || halving == 20) {
+				break;
+			}
+			updateSufficientStatistics(-delta, index);
+			delta /= 2.0;
+		}
+
+		const bool done = computeConvergenceCriterion(newLogLikelihood, logLikelihood) < arguments.tolerance;
+		logLikelihood = newLogLikelihood;
+		if (done) {
+			flag = SUCCESS;
+			break;
+		}
+	}
+
+	double gradient;
+	computeNumeratorForGradient(index);
+	computeGradientAndHessian(index, &gradient, &hessian);
+
+	estimate = hBeta[index];
+	setBeta(index, start);
+
+	return flag;
+}
+
+double CyclicCoordinateDescent::getLogPriorGradient(int index) {
+	if (jointPrior->getIsSmooth(index)) {
+		return -jointPrior->getGradientHessian(hBeta, index).first;
+	}
+	if (jointPrior->getSupportsSafeScreening(index)) { // lambda * |beta|
+		const double lambda = jointPrior->getKktBoundary(index);
+		if (lambda == 0.0) {
+			return 0.0;
+		}
+		if (hBeta[index] == 0.0) {
+			return NAN; // Only a subdifferential at the kink
+		}
+		return (hBeta[index] > 0.0) ? -lambda : lambda;
+	}
+	return NAN;
+}
+
 double CyclicCoordinateDescent::getAsymptoticVariance(int indexOne, int indexTwo) {
 	checkAllLazyFlags();
 	if (!fisherInformationKnown) {
@@ -1227,7 +1753,7 @@ double CyclicCoordinateDescent::getAsymptoticVariance(int indexOne, int indexTwo
 	if (itOne == hessianIndexMap.end() || itTwo == hessianIndexMap.end()) {
 		return NAN;
 	} else {
-		return varianceMatrix(itOne->second, itTwo->second);
+		return getInverseEntry(hessianFactorization, itOne->second, itTwo->second);
 	}
 }
 
@@ -1249,19 +1775,59 @@ double CyclicCoordinateDescent::getAsymptoticPrecision(int indexOne, int indexTw
 }
 
 CyclicCoordinateDescent::Matrix CyclicCoordinateDescent::computeFisherInformation(const std::vector<size_t>& indices) const {
-    Matrix fisherInformation(indices.size(), indices.size());
-    for (size_t ii = 0; ii < indices.size(); ++ii) {
-        const int i = indices[ii];
-        for (size_t jj = ii; jj < indices.size(); ++jj) {
-            const int j = indices[jj];
-            double element = 0.0;
-             modelSpecifics.computeFisherInformation(i, j, &element, useCrossValidation);
-            fisherInformation(jj, ii) = fisherInformation(ii, jj) = element;
-        }
-    }
+    const std::vector<int> columns(indices.begin(), indices.end());
+    Matrix fisherInformation(columns.size(), columns.size());
+    modelSpecifics.computeFisherInformationMatrix(columns, fisherInformation.data(),
+                                                  useCrossValidation, threadCount);
     return fisherInformation;
 }
 
+std::vector<double> CyclicCoordinateDescent::computeAsymptoticVarianceDiagonal(const std::vector<size_t>& indices) const {
+    const Eigen::LDLT<Matrix> factorization(computeFisherInformation(indices));
+    std::vector<double> variance(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        variance[i] = getInverseEntry(factorization, i, i);
+    }
+    return variance;
+}
+
+double CyclicCoordinateDescent::getApproximateLeaveOutLogLikelihood() {
+	checkAllLazyFlags();
+
+	if (useCrossValidation) {
+		std::ostringstream stream;
+		stream << "Approximate leave-one-out requires an unweighted fit";
+		error->throwError(stream);
+	}
+
+	computeAsymptoticPrecisionMatrix();
+	fisherInformationKnown = true;
+	varianceKnown = false;
+
+	std::vector<int> indices(hessianIndexMap.size());
+	for (const auto& entry : hessianIndexMap) {
+		indices[entry.second] = entry.first;
+	}
+
+	// Curvature of the penalized objective at the mode
+	Matrix curvature = modelSpecifics.getFisherInformationScale() * hessianMatrix;
+	for (size_t i = 0; i < indices.size(); ++i) {
+		curvature(i, i) += jointPrior->getGradientHessian(hBeta, indices[i]).second;
+	}
+	const Matrix inverseCurvature = curvature.ldlt().solve(Matrix::Identity(indices.size(), indices.size()));
+
+	const double logLikelihood = modelSpecifics.getApproximateLeaveOutLogLikelihood(indices,
+			inverseCurvature.data(), threadCount);
+
+	if (std::isnan(logLikelihood)) {
+		std::ostringstream stream;
+		stream << "Approximate leave-one-out is not available for this model type";
+		error->throwError(stream);
+	}
+
+	return logLikelihood;
+}
+
 void CyclicCoordinateDescent::computeAsymptoticPrecisionMatrix(void) {
 
 	typedef std::vector<int> int_vec;
@@ -1279,39 +1845,12 @@ void CyclicCoordinateDescent::computeAsymptoticPrecisionMatrix(void) {
 	}
 
 	hessianMatrix.resize(indices.size(), indices.size());
-	modelSpecifics.makeDirty(); // clear hessian terms
-
-	for (size_t ii = 0; ii < indices.size(); ++ii) {
-		for (size_t jj = ii; jj < indices.size(); ++jj) {
-			const int i = indices[ii];
-			const int j = indices[jj];
-//			std::cerr << "(" << i << "," << j << ")" << std::endl;
-			double fisherInformation = 0.0;
-			modelSpecifics.computeFisherInformation(i, j, &fisherInformation, useCrossValidation);
-//			if (fisherInformation != 0.0) {
-				// Add tuple to sparse matrix
-//				tripletList.push_back(Triplet<double>(ii,jj,fisherInformation));
-//			}
-			hessianMatrix(jj,ii) = hessianMatrix(ii,jj) = fisherInformation;
-
-		}
-	}
-
-//	sm.setFromTriplets(tripletList.begin(), tripletList.end());
-//	cout << sm;
-//	auto inv = sm.triangularView<Upper>().solve(dv1);
-//	cout << sm.inverse();
-//	cout << hessianMatrix << endl;
-
-	// Take inverse
-//	hessianMatrix = hessianMatrix.inverse();
-
-//	cout << hessianMatrix << endl;
+	modelSpecifics.computeFisherInformationMatrix(indices, hessianMatrix.data(),
+			useCrossValidation, threadCount);
 }
 
 void CyclicCoordinateDescent::computeAsymptoticVarianceMatrix(void) {
-	varianceMatrix = hessianMatrix.inverse();
-// 	cout << varianceMatrix << endl;
+	hessianFactorization.compute(hessianMatrix);
 }
 
 void CyclicCoordinateDescent::mmUpdateAllBeta(std::vector<double>& delta,
@@ -1353,6 +1892,253 @@ void CyclicCoordinateDescent::mmUpdateAllBeta(std::vector<double>& delta,
     }
 }
 
+bool CyclicCoordinateDescent::getCanUseNewton(const std::vector<bool>& fixedBeta) const {
+    if (useCrossValidation) { // Fisher information is not yet weighted
+        return false;
+    }
+    for (int j = 0; j < J; ++j) {
+        if (!fixedBeta[j] && !jointPrior->getIsSmooth(j)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CyclicCoordinateDescent::newtonUpdateAllBeta(const std::vector<bool>& fixedBeta) {
+
+    if (!sufficientStatisticsKnown) {
+        std::ostringstream stream;
+        stream << "Error in state synchronization.";
+        error->throwError(stream);
+    }
+
+    std::vector<int> indices;
+    for (int j = 0; j < J; ++j) {
+        if (!fixedBeta[j]) {
+            indices.push_back(j);
+        }
+    }
+    const int P = static_cast<int>(indices.size());
+    if (P == 0) {
+        return;
+    }
+
+    // Penalized gradient and full Hessian at current beta
+    Eigen::VectorXd gradient(P);
+    Matrix hessian(P, P);
+    const double fisherScale = modelSpecifics.getFisherInformationScale();
+
+    for (int ii = 0; ii < P; ++ii) {
+        const int i = indices[ii];
+
+        computeNumeratorForGradient(i);
+        priors::GradientHessian gh;
+        computeGradientAndHessian(i, &gh.first, &gh.second);
+        const auto prior = jointPrior->getGradientHessian(hBeta, i);
+        gradient(ii) = gh.first + prior.first;
+
+        for (int jj = ii; jj < P; ++jj) {
+            double element = 0.0;
+            modelSpecifics.computeFisherInformation(i, indices[jj], &element, useCrossValidation);
+            hessian(jj, ii) = hessian(ii, jj) = fisherScale * element;
+        }
+        hessian(ii, ii) += prior.second;
+    }
+
+    // Damp until positive-definite
+    const double scale = 1.0 + hessian.diagonal().cwiseAbs().maxCoeff();
+    double damping = 0.0;
+    Eigen::LLT<Matrix> llt(hessian);
+    while (llt.info() != Eigen::Success && damping < 1E8 * scale) {
+        damping = (damping == 0.0) ? 1E-8 * scale : 10.0 * damping;
+        llt.compute(hessian + damping * Matrix::Identity(P, P));
+    }
+    if (llt.info() != Eigen::Success) {
+        return;
+    }
+    const Eigen::VectorXd step = -llt.solve(gradient);
+
+    // Step-halving to guarantee ascent
+    const double lastObjective = getLogLikelihood() + getLogPrior();
+    const DoubleVector savedBeta(hBeta);
+
+    const int maxHalvings = 20;
+    double fraction = 1.0;
+    for (int halving = 0; halving < maxHalvings; ++halving) {
+        for (int ii = 0; ii < P; ++ii) {
+            hBeta[indices[ii]] = savedBeta[indices[ii]] + fraction * step(ii);
+        }
+        modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
+        computeRemainingStatistics(true, 0);
+        sufficientStatisticsKnown = true;
+
+        const double objective = getLogLikelihood() + getLogPrior();
+        if (objective >= lastObjective) {
+            return;
+        }
+        fraction *= 0.5;
+    }
+
+    // No ascent direction found; stay put and let convergence check terminate
+    hBeta = savedBeta;
+    modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
+    computeRemainingStatistics(true, 0);
+    sufficientStatisticsKnown = true;
+}
+
+void CyclicCoordinateDescent::fistaUpdateAllBeta(const std::vector<bool>& fixedBeta) {
+
+    if (!sufficientStatisticsKnown) {
+        std::ostringstream stream;
+        stream << "Error in state synchronization.";
+        error->throwError(stream);
+    }
+
+    const DoubleVector current(hBeta);
+    const double currentObjective = getLogLikelihood() + getLogPrior();
+
+    const double nextMomentum = 0.5 * (1.0 + std::sqrt(1.0 + 4.0 * fistaMomentum * fistaMomentum));
+    const double extrapolation = (fistaMomentum - 1.0) / nextMomentum;
+
+    const int maxHalvings = 50;
+    DoubleVector point(J);
+
+    // First try the accelerated step; if it loses ground, restart momentum from the current iterate
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        const double weight = (attempt == 0) ? extrapolation : 0.0;
+        if (attempt == 1 && weight == extrapolation) {
+            break;
+        }
+
+        for (int j = 0; j < J; ++j) {
+            point[j] = fixedBeta[j] ? current[j] :
+                current[j] + weight * (current[j] - fistaPrevious[j]);
+        }
+
+        if (hBeta != point) {
+            hBeta = point;
+            modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
+            computeRemainingStatistics(true, 0);
+            sufficientStatisticsKnown = true;
+        }
+
+        const double pointLoss = -getLogLikelihood();
+        modelSpecifics.computeGradient(fistaGradient, fixedBeta, useCrossValidation, threadCount);
+
+        fistaStep *= 2.0; // Let the step recover after earlier backtracking
+
+        // Backtrack until the quadratic model at the extrapolated point majorizes the loss
+        for (int halving = 0; halving < maxHalvings; ++halving) {
+            double linear = 0.0;
+            double quadratic = 0.0;
+            for (int j = 0; j < J; ++j) {
+                if (!fixedBeta[j]) {
+                    // Prior delta at curvature 1/step is the proximal map of the penalty
+                    const priors::GradientHessian gh(fistaGradient[j], 1.0 / fistaStep);
+                    const double difference = jointPrior->getDelta(gh, point, j);
+                    hBeta[j] = point[j] + difference;
+                    linear += fistaGradient[j] * difference;
+                    quadratic += difference * difference;
+                }
+            }
+            modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
+            computeRemainingStatistics(true, 0);
+            sufficientStatisticsKnown = true;
+
+            const double loss = -getLogLikelihood();
+            const double bound = pointLoss + linear + quadratic / (2.0 * fistaStep);
+            if (loss <= bound + 1E-12 * std::abs(bound)) {
+                break;
+            }
+            fistaStep *= 0.5;
+        }
+
+        const double objective = getLogLikelihood() + getLogPrior();
+        if (objective >= currentObjective) {
+            fistaPrevious = current;
+            fistaMomentum = (attempt == 0) ? nextMomentum : 1.0;
+            return;
+        }
+    }
+
+    // No progress from either point; stay put and let convergence check terminate
+    hBeta = current;
+    fistaPrevious = current;
+    fistaMomentum = 1.0;
+    modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
+    computeRemainingStatistics(true, 0);
+    sufficientStatisticsKnown = true;
+}
+
+void CyclicCoordinateDescent::irlsUpdateAllBeta(const std::vector<bool>& fixedBeta, double epsilon) {
+
+    if (!sufficientStatisticsKnown) {
+        std::ostringstream stream;
+        stream << "Error in state synchronization.";
+        error->throwError(stream);
+    }
+
+    const DoubleVector anchor(hBeta);
+    const double anchorObjective = getLogLikelihood() + getLogPrior();
+
+    // Inner loop: coordinate descent on the penalized weighted least-squares approximation,
+    // which moves xBeta linearly and evaluates no transcendentals
+    modelSpecifics.setQuadraticApproximation(true, useCrossValidation);
+
+    const int maxSweeps = 100;
+    const double tolerance = 0.1 * epsilon * (std::abs(anchorObjective) + 1.0);
+    bool fullSweep = true;
+
+    for (int sweep = 0; sweep < maxSweeps; ++sweep) {
+        double largestChange = 0.0;
+        for (int index = 0; index < J; ++index) {
+            if (fixedBeta[index] || (!fullSweep && hBeta[index] == 0.0)) {
+                continue; // Between full sweeps, only visit the active set
+            }
+            const double delta = ccdUpdateBeta(index);
+            if (delta != 0.0) {
+                hBeta[index] += delta;
+                modelSpecifics.updateXBeta(delta, index, useCrossValidation);
+                largestChange = std::max(largestChange, coordinateScores[index] * std::abs(delta));
+            }
+        }
+        const bool converged = largestChange < tolerance;
+        if (converged && fullSweep) {
+            break;
+        }
+        fullSweep = converged; // Confirm a converged active set with a full sweep
+    }
+
+    // Outer step: refresh exact statistics once and halve towards the anchor until the true objective does not decrease
+    modelSpecifics.setQuadraticApproximation(false, useCrossValidation);
+
+    const DoubleVector proposal(hBeta);
+    const int maxHalvings = 20;
+    double scale = 1.0;
+
+    for (int halving = 0; halving <= maxHalvings; ++halving) {
+        if (halving > 0) {
+            scale *= 0.5;
+            for (int j = 0; j < J; ++j) {
+                hBeta[j] = anchor[j] + scale * (proposal[j] - anchor[j]);
+            }
+        }
+        modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
+        computeRemainingStatistics(true, 0);
+        sufficientStatisticsKnown = true;
+
+        const double objective = getLogLikelihood() + getLogPrior();
+        if (objective >= anchorObjective) {
+            return;
+        }
+    }
+
+    // No ascent found; stay put and let convergence check terminate
+    hBeta = anchor;
+    modelSpecifics.computeXBeta(hBeta.data(), useCrossValidation);
+    computeRemainingStatistics(true, 0);
+    sufficientStatisticsKnown = true;
+}
 
 double CyclicCoordinateDescent::ccdUpdateBeta(int index) {
 
@@ -1372,7 +2158,111 @@ double CyclicCoordinateDescent::ccdUpdateBeta(int index) {
 	    gh.second = 0.0;
 	}
 
-	return jointPrior->getDelta(gh, hBeta, index);
+	const double delta = jointPrior->getDelta(gh, hBeta, index);
+
+	// Newton-scaled step approximates |penalized gradient| and is zero at KKT-satisfying zeros
+	coordinateScores[index] = std::abs(delta * gh.second);
+
+	return delta;
+}
+
+void CyclicCoordinateDescent::scheduleCoordinates(std::vector<int>& order) {
+
+	order.clear();
+	for (int index = 0; index < J; ++index) {
+		if (!fixBeta[index]) {
+			order.push_back(index);
+		}
+	}
+
+	if (coordinateSelection == CoordinateSelectionType::RANDOM) {
+
+		std::shuffle(order.begin(), order.end(), coordinatePrng);
+
+	} else if (coordinateSelection == CoordinateSelectionType::HYBRID) {
+
+		// Reserve the front of the cycle for the top-k violators of the last cycle, then sweep all
+		typedef std::pair<double,int> ScoreEntry;
+		auto compare = [] (const ScoreEntry& lhs, const ScoreEntry& rhs) {
+			return lhs.first < rhs.first ||
+				(lhs.first == rhs.first && lhs.second > rhs.second); // ties in cyclic order
+		};
+		std::priority_queue<ScoreEntry, std::vector<ScoreEntry>, decltype(compare)> queue(compare);
+		for (int index : order) {
+			queue.push(std::make_pair(coordinateScores[index], index));
+		}
+
+		const size_t k = static_cast<size_t>(std::ceil(hybridFraction * order.size()));
+		std::vector<int> violators;
+		while (!queue.empty() && violators.size() < k && queue.top().first > 0.0) {
+			violators.push_back(queue.top().second);
+			queue.pop();
+		}
+		order.insert(order.begin(), violators.begin(), violators.end());
+	}
+}
+
+void CyclicCoordinateDescent::greedyUpdateAllBeta(const std::vector<bool>& fixedBeta) {
+
+	// Gauss-Southwell: visit each free coordinate once per cycle, always the one with the largest score.
+	// Scores go stale as xBeta moves, so a stale leader is refreshed against the current state first,
+	// and goes back into the queue (at most once per cycle) if it no longer leads.
+	struct Candidate {
+		double score;
+		int index;
+		int stamp; // Number of updates applied when score and delta were computed
+		double delta;
+	};
+	auto compare = [] (const Candidate& lhs, const Candidate& rhs) {
+		return lhs.score < rhs.score ||
+			(lhs.score == rhs.score && lhs.index > rhs.index); // ties in cyclic order
+	};
+	std::priority_queue<Candidate, std::vector<Candidate>, decltype(compare)> queue(compare);
+	for (int index = 0; index < J; ++index) {
+		if (!fixedBeta[index]) {
+			queue.push(Candidate{coordinateScores[index], index, -1, 0.0});
+		}
+	}
+
+	std::vector<bool> deferred(J, false);
+	int updates = 0;
+
+	while (!queue.empty()) {
+		const Candidate candidate = queue.top();
+		queue.pop();
+		const int index = candidate.index;
+
+		double delta = candidate.delta;
+		if (candidate.stamp != updates) {
+			delta = ccdUpdateBeta(index); // Refreshes coordinateScores[index]
+			if (!deferred[index] && !queue.empty() && coordinateScores[index] < queue.top().score) {
+				deferred[index] = true;
+				queue.push(Candidate{coordinateScores[index], index, updates, delta});
+				continue;
+			}
+		}
+
+		delta = applyBounds(delta, index);
+		if (delta != 0.0) {
+			sufficientStatisticsKnown = false;
+			updateSufficientStatistics(delta, index);
+			++updates;
+		}
+	}
+}
+
+void CyclicCoordinateDescent::seedCoordinatePrng(long seed) {
+	coordinateSeed = seed;
+	auto base = static_cast<std::mt19937::result_type>(seed);
+	if (seed == -1 || seed == -99) {
+		base = std::mt19937::default_seed; // Unseeded fits stay reproducible
+	}
+	coordinatePrng.seed(base + static_cast<std::mt19937::result_type>(coordinateStream));
+}
+
+void CyclicCoordinateDescent::setCoordinateStream(int stream) {
+	coordinateStream = stream;
+	seedCoordinatePrng(coordinateSeed);
 }
 
 void CyclicCoordinateDescent::axpyXBeta(const double beta, const int j) {
@@ -17,6 +17,7 @@
 
 #include <Eigen/Dense>
 #include <deque>
+#include <random>
 
 #include "Types.h"
 
@@ -67,6 +68,9 @@ public:
 
 	CyclicCoordinateDescent* clone();
 
+	// Shares data and prior, but fits outcome (one value per row)
+	CyclicCoordinateDescent* clone(const std::vector<double>& outcome);
+
 	void logResults(const char* fileName, bool withASE);
 
 	virtual ~CyclicCoordinateDescent();
@@ -97,6 +101,12 @@ public:
 
 	double getHessianDiagonal(int index);
 
+	double getLogLikelihoodGradient(int index); // d logLikelihood / d beta[index]
+
+	double getLogPriorGradient(int index); // d logPrior / d beta[index], NaN where it does not exist
+
+	double getScoreStatistic(int index); // gradient^2 / hessian of the log likelihood at the current beta
+
 	double getAsymptoticVariance(int i, int j);
 
 	double getAsymptoticPrecision(int i, int j);
@@ -105,11 +115,34 @@ public:
 
 	void update(const ModeFindingArguments& arguments);
 
+	// Lanes fit one model per variance of the single prior hyperparameter, and optionally per outcome,
+	// sharing each pass over a column
+	bool getSupportsLanes(const ModeFindingArguments& arguments) const;
+
+	// beta (J x variances, lane index fastest) holds starting values on entry and estimates on exit;
+	// outcomes (K x variances, lane index fastest) replace the shared outcome when given.
+	// The state of this object (beta, xBeta, hyperparameters) is left unchanged
+	void updateLanes(const ModeFindingArguments& arguments, const std::vector<double>& variances,
+			std::vector<double>& beta, std::vector<UpdateReturnFlags>& returnFlags,
+			const double* outcomes = nullptr);
+
+	// Log likelihood of each lane of the last updateLanes(); logLikelihoods holds one entry per lane
+	void getLaneLogLikelihoods(std::vector<double>& logLikelihoods);
+
+	// Unpenalized Newton fit of beta[index] alone, with the current linear predictor held fixed as an offset;
+	// beta[index] is restored on exit
+	UpdateReturnFlags fitUnivariable(int index, const ModeFindingArguments& arguments,
+			double& estimate, double& hessian, double& logLikelihood);
+
 	virtual void resetBeta(void);
 
 	// Setters
 	void setPrior(priors::JointPriorPtr newPrior);
 
+	bool setPrivatePrior(); // Stop sharing hyperparameters with the object this was cloned from
+
+	void setCoordinateStream(int stream); // Draw random coordinate orders from seed + stream, e.g. per clone
+
 	void setHyperprior(double value); // TODO depricate
 
 	void setHyperprior(int index, double value);
@@ -167,12 +200,24 @@ public:
 
 	void setInitialBound(double bound);
 
+	void setThreadCount(int threads);
+
 	Matrix computeFisherInformation(const std::vector<size_t>& indices) const;
 
+	std::vector<double> computeAsymptoticVarianceDiagonal(const std::vector<size_t>& indices) const;
+
+	double getApproximateLeaveOutLogLikelihood();
+
+	CacheStatistics getCrossTermCacheStatistics() const { return modelSpecifics.getCrossTermCacheStatistics(); }
+
+	void setWeightPatternCount(int count) { modelSpecifics.setWeightPatternCount(count); }
+
 	loggers::ProgressLogger& getProgressLogger() const { return *logger; }
 
 	loggers::ErrorHandler& getErrorHandler() const { return *error; }
 
+	const AbstractModelData& getModelData() const { return hXI; }
+
 protected:
 
 	bsccs::unique_ptr<AbstractModelSpecifics> privateModelSpecifics;
@@ -183,6 +228,8 @@ protected:
 
 	CyclicCoordinateDescent(const CyclicCoordinateDescent& copy);
 
+	CyclicCoordinateDescent(const CyclicCoordinateDescent& copy, AbstractModelSpecifics* specifics);
+
 	void init(bool offset);
 
 	void resetBounds(void);
@@ -208,6 +255,8 @@ protected:
 
 	void kktSwindle(const ModeFindingArguments& arguments);
 
+	int safeScreenCovariates();
+
 	void computeSufficientStatistics(void);
 
 	void updateSufficientStatistics(double delta, int index);
@@ -261,10 +310,28 @@ protected:
 
 	double ccdUpdateBeta(int index);
 
+	void scheduleCoordinates(std::vector<int>& order);
+
+	void greedyUpdateAllBeta(const std::vector<bool>& fixedBeta);
+
+	void seedCoordinatePrng(long seed);
+
 
 	void mmUpdateAllBeta(std::vector<double>& allDelta,
                          const std::vector<bool>& fixedBeta);
 
+	void newtonUpdateAllBeta(const std::vector<bool>& fixedBeta);
+
+	bool getCanUseNewton(const std::vector<bool>& fixedBeta) const;
+
+	void fistaUpdateAllBeta(const std::vector<bool>& fixedBeta);
+
+	void irlsUpdateAllBeta(const std::vector<bool>& fixedBeta, double epsilon);
+
+	std::vector<int> mergeDuplicateCovariates();
+
+	void splitDuplicateCovariates(const std::vector<int>& merged);
+
 
 	double applyBounds(
 			double inDelta,
@@ -341,6 +408,24 @@ protected:
 
 	double initialBound;
 
+	CoordinateSelectionType coordinateSelection;
+	double hybridFraction;
+	DoubleVector coordinateScores; // Last observed (Newton-scaled) gradient magnitude per coordinate
+	std::mt19937 coordinatePrng;
+	long coordinateSeed; // Control seed last used for coordinatePrng
+	int coordinateStream; // Offset of coordinatePrng's seed, so clones shuffle independently
+	int newtonThreshold;
+	int threadCount;
+
+	DoubleVector fistaGradient;
+	DoubleVector fistaPrevious; // Iterate before last, for momentum
+	double fistaMomentum;
+	double fistaStep;
+
+	std::vector<bool> screenedOut; // Proven zero at the mode; empty unless screening is active
+	std::vector<bool> screeningExcluded; // Fixed before screening began
+	DoubleVector screeningNorms;
+
 	bool sufficientStatisticsKnown;
 	bool xBetaKnown;
 	bool fisherInformationKnown;
@@ -359,7 +444,7 @@ protected:
 	int lastIterationCount;
 
 	Matrix hessianMatrix;
-	Matrix varianceMatrix;
+	Eigen::LDLT<Matrix> hessianFactorization; // Variance entries are solved for on request
 
 	typedef std::map<int, int> IndexMap;
 	IndexMap hessianIndexMap;
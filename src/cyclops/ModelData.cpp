@@ -16,6 +16,8 @@
 #include <numeric>
 #include <list>
 #include <functional>
+#include <unordered_map>
+#include <tuple>
 
 #include <boost/iterator/permutation_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
@@ -629,6 +631,264 @@ void ModelData<RealType>::convertCovariateToDense(const IdType covariate) {
     X.getColumn(index).convertColumnToDense(getNumberOfRows());
 }
 
+template <typename RealType>
+size_t ModelData<RealType>::findDuplicateCovariates() {
+
+    const size_t J = getNumberOfCovariates();
+    const size_t K = getNumberOfRows();
+
+    duplicateOf.assign(J, -1);
+    complementOf.assign(J, -1);
+
+    const size_t first = hasOffsetCovariate ? 1 : 0;
+    const size_t intercept = hasInterceptCovariate ? first : J;
+
+    auto sameRows = [this](const size_t one, const size_t two) {
+        const auto& rowsOne = X.getCompressedColumnVectorSTL(one);
+        const auto& rowsTwo = X.getCompressedColumnVectorSTL(two);
+        return rowsOne == rowsTwo;
+    };
+
+    auto disjointRows = [this](const size_t one, const size_t two) {
+        const auto& rowsOne = X.getCompressedColumnVectorSTL(one);
+        const auto& rowsTwo = X.getCompressedColumnVectorSTL(two);
+        auto itOne = rowsOne.begin();
+        auto itTwo = rowsTwo.begin();
+        while (itOne != rowsOne.end() && itTwo != rowsTwo.end()) {
+            if (*itOne == *itTwo) {
+                return false;
+            }
+            if (*itOne < *itTwo) {
+                ++itOne;
+            } else {
+                ++itTwo;
+            }
+        }
+        return true;
+    };
+
+    // Bucket indicator columns by (entry count, sum of row indices, hash of row set)
+    typedef std::tuple<size_t, size_t, size_t> Signature;
+    struct SignatureHash {
+        size_t operator()(const Signature& s) const {
+            return std::get<2>(s) ^ (std::get<0>(s) * 0x9e3779b9) ^ (std::get<1>(s) << 1);
+        }
+    };
+
+    std::unordered_map<Signature, std::vector<size_t>, SignatureHash> buckets;
+
+    for (size_t j = first; j < J; ++j) {
+        if (j == intercept || X.getFormatType(j) != INDICATOR) {
+            continue;
+        }
+        const auto& rows = X.getCompressedColumnVectorSTL(j);
+        size_t sum = 0;
+        size_t hash = rows.size();
+        for (const auto row : rows) {
+            sum += row;
+            hash ^= std::hash<int>()(row) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        buckets[Signature(rows.size(), sum, hash)].push_back(j);
+    }
+
+    size_t count = 0;
+    for (auto& bucket : buckets) {
+        auto& columns = bucket.second;
+        for (size_t a = 0; a < columns.size(); ++a) {
+            if (duplicateOf[columns[a]] != -1) continue;
+            for (size_t b = a + 1; b < columns.size(); ++b) {
+                if (duplicateOf[columns[b]] == -1 && sameRows(columns[a], columns[b])) {
+                    duplicateOf[columns[b]] = static_cast<int>(columns[a]);
+                    ++count;
+                }
+            }
+        }
+    }
+
+    // Complements share no rows and together cover all rows; look up by (count, sum of row indices)
+    const size_t totalSum = K * (K - 1) / 2;
+    std::map<std::pair<size_t, size_t>, std::vector<size_t>> representatives;
+    for (auto& bucket : buckets) {
+        for (const auto j : bucket.second) {
+            if (duplicateOf[j] == -1) {
+                representatives[std::make_pair(std::get<0>(bucket.first), std::get<1>(bucket.first))].push_back(j);
+            }
+        }
+    }
+    for (auto& entry : representatives) {
+        const auto key = std::make_pair(K - entry.first.first, totalSum - entry.first.second);
+        auto match = representatives.find(key);
+        if (match == representatives.end()) continue;
+        for (const auto one : entry.second) {
+            for (const auto two : match->second) {
+                if (one < two && complementOf[two] == -1 && disjointRows(one, two)) {
+                    complementOf[two] = static_cast<int>(one);
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+namespace {
+
+// Keep only the listed (increasing) entries of a per-row vector; empty vectors are not loaded
+template <typename VectorType>
+void keepRows(VectorType& vector, const std::vector<size_t>& rows) {
+    if (vector.empty()) {
+        return;
+    }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        vector[i] = vector[rows[i]];
+    }
+    vector.resize(rows.size());
+}
+
+} // namespace
+
+template <typename RealType>
+size_t ModelData<RealType>::aggregateRows() {
+
+    if ((modelType != ModelType::LOGISTIC && modelType != ModelType::POISSON) || !rowMap.empty()) {
+        return 0;
+    }
+
+    const size_t J = getNumberOfCovariates();
+    const size_t K = getNumberOfRows();
+
+    if (y.size() != K
+        || (offs.size() > 0 && offs.size() != K)
+        || (z.size() > 0 && z.size() != K)
+        || (nevents.size() > 0 && nevents.size() != K)
+    ) {
+        std::ostringstream stream;
+        stream << "Mismatched outcome column dimensions";
+        error->throwError(stream);
+    }
+
+    const bool hasTime = (offs.size() == K);
+
+    // Sparse signature of each row as (column, value) pairs in column order
+    typedef std::vector<std::pair<int, RealType>> RowSignature;
+    std::vector<RowSignature> signatures(K);
+    for (size_t j = 0; j < J; ++j) {
+        const auto format = X.getFormatType(j);
+        if (format == INTERCEPT) {
+            continue;
+        }
+        if (format == DENSE) {
+            const auto& data = X.getDataVectorSTL(j);
+            for (size_t k = 0; k < data.size(); ++k) {
+                if (data[k] != static_cast<RealType>(0)) {
+                    signatures[k].emplace_back(j, data[k]);
+                }
+            }
+        } else {
+            const auto& rows = X.getCompressedColumnVectorSTL(j);
+            for (size_t i = 0; i < rows.size(); ++i) {
+                signatures[rows[i]].emplace_back(j, (format == SPARSE) ?
+                    X.getDataVectorSTL(j)[i] : static_cast<RealType>(1));
+            }
+        }
+    }
+
+    auto combine = [](size_t hash, size_t value) {
+        return hash ^ (value + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+    };
+
+    auto hashRow = [&](const size_t k) {
+        size_t hash = std::hash<RealType>()(y[k]);
+        if (hasTime) {
+            hash = combine(hash, std::hash<RealType>()(offs[k]));
+        }
+        for (const auto& entry : signatures[k]) {
+            hash = combine(hash, std::hash<int>()(entry.first));
+            hash = combine(hash, std::hash<RealType>()(entry.second));
+        }
+        return hash;
+    };
+
+    auto sameRow = [&](const size_t one, const size_t two) {
+        return y[one] == y[two] && (!hasTime || offs[one] == offs[two]) &&
+            signatures[one] == signatures[two];
+    };
+
+    std::unordered_map<size_t, std::vector<int>> buckets;
+    std::vector<size_t> representatives; // First original row of each aggregated row
+
+    rowMap.assign(K, -1);
+    rowMultiplicity.clear();
+
+    for (size_t k = 0; k < K; ++k) {
+        auto& bucket = buckets[hashRow(k)];
+        int target = -1;
+        for (const auto candidate : bucket) {
+            if (sameRow(representatives[candidate], k)) {
+                target = candidate;
+                break;
+            }
+        }
+        if (target == -1) {
+            target = static_cast<int>(representatives.size());
+            representatives.push_back(k);
+            rowMultiplicity.push_back(0.0);
+            bucket.push_back(target);
+        }
+        rowMap[k] = target;
+        rowMultiplicity[target] += 1.0;
+    }
+
+    const size_t aggregated = representatives.size();
+    if (aggregated == K) {
+        rowMap.clear();
+        rowMultiplicity.clear();
+        return 0;
+    }
+
+    // Representatives are increasing, so compacted sparse columns stay sorted
+    for (size_t j = 0; j < J; ++j) {
+        auto& column = X.getColumn(j);
+        const auto format = column.getFormatType();
+        if (format == DENSE) {
+            auto& data = column.getDataVector();
+            data.resize(K, static_cast<RealType>(0));
+            keepRows(data, representatives);
+        } else if (format == SPARSE || format == INDICATOR) {
+            auto& rows = column.getColumnsVector();
+            size_t out = 0;
+            for (size_t i = 0; i < rows.size(); ++i) {
+                const auto k = rows[i];
+                if (representatives[rowMap[k]] == static_cast<size_t>(k)) {
+                    rows[out] = rowMap[k];
+                    if (format == SPARSE) {
+                        column.getDataVector()[out] = column.getDataVector()[i];
+                    }
+                    ++out;
+                }
+            }
+            rows.resize(out);
+            if (format == SPARSE) {
+                column.getDataVector().resize(out);
+            }
+        }
+    }
+
+    keepRows(y, representatives);
+    keepRows(offs, representatives);
+    keepRows(z, representatives);
+    keepRows(nevents, representatives);
+
+    pid.resize(aggregated);
+    std::iota(pid.begin(), pid.end(), 0);
+    nPatients = 0;
+    nStrata = 0;
+
+    X.nRows = aggregated;
+
+    return K - aggregated;
+}
+
 template <typename RealType>
 void ModelData<RealType>::setOffsetCovariate(const IdType covariate) {
     int index;
@@ -122,6 +122,18 @@ public:
 
     virtual void convertCovariateToDense(const IdType covariate) = 0;
 
+    virtual size_t findDuplicateCovariates() = 0;
+
+    virtual int getDuplicateOf(const size_t index) const = 0;
+
+    virtual int getComplementOf(const size_t index) const = 0;
+
+    virtual size_t aggregateRows() = 0;
+
+    virtual const std::vector<int>& getAggregatedRowMap() const = 0;
+
+    virtual const std::vector<double>& getRowMultiplicity() const = 0;
+
 	virtual double innerProductWithOutcome(const size_t index) const = 0;
 
     virtual void loadY(
@@ -365,6 +377,26 @@ public:
 
 	void convertCovariateToDense(const IdType covariate);
 
+	size_t findDuplicateCovariates();
+
+	int getDuplicateOf(const size_t index) const {
+	    return (index < duplicateOf.size()) ? duplicateOf[index] : -1;
+	}
+
+	int getComplementOf(const size_t index) const {
+	    return (index < complementOf.size()) ? complementOf[index] : -1;
+	}
+
+	size_t aggregateRows();
+
+	const std::vector<int>& getAggregatedRowMap() const {
+	    return rowMap;
+	}
+
+	const std::vector<double>& getRowMultiplicity() const {
+	    return rowMultiplicity;
+	}
+
     size_t getNumberOfCovariates() const {
         return getNumberOfColumns();
     }
@@ -386,7 +418,7 @@ public:
 	}
 
 	bool getHasRowLabels() const {
-		return (labels.size() == getNumberOfRows());
+		return (labels.size() == (rowMap.empty() ? getNumberOfRows() : rowMap.size()));
 	}
 
 	bool getIsFinalized() const {
@@ -743,6 +775,12 @@ protected:
 	std::string conditionId;
 	std::vector<std::string> labels; // TODO Change back to 'long'
 
+	std::vector<int> duplicateOf; // Representative column index for identical indicator columns, or -1
+	std::vector<int> complementOf; // Earlier column whose row set is the exact complement, or -1
+
+	std::vector<int> rowMap; // Aggregated row for each original row, empty if rows are not aggregated
+	std::vector<double> rowMultiplicity; // Number of original rows collapsed into each aggregated row
+
 	int nTypes;
 
 private:
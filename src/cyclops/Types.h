@@ -129,6 +129,23 @@ enum UpdateReturnFlags {
 	MISSING_COVARIATES
 };
 
+struct ProfilePointInformation {
+	int iterations;
+	UpdateReturnFlags status;
+	double start; // Value of the profiled coefficient the refit was warm-started from
+
+	ProfilePointInformation() : iterations(0), status(SUCCESS), start(0.0) { }
+};
+
+struct CacheStatistics {
+	long hits;
+	long misses;
+	long evictions;
+	size_t bytes; // Currently held
+
+	CacheStatistics() : hits(0), misses(0), evictions(0), bytes(0) { }
+};
+
 typedef std::vector<IdType> ProfileVector;
 
 enum class ModelType {
@@ -148,6 +165,17 @@ enum class ModelType {
 enum class AlgorithmType {
 	CCD = 0,
 	MM,
+	NEWTON,
+	FISTA,
+	IRLS,
+	SIZE_OF_ENUM // Keep at end
+};
+
+enum class CoordinateSelectionType {
+	CYCLIC = 0,
+	RANDOM,
+	GREEDY,
+	HYBRID,
 	SIZE_OF_ENUM // Keep at end
 };
 
@@ -70,6 +70,9 @@ void AbstractCrossValidationDriver::drive(
 
 	for (int i = 1; i < nThreads; ++i) {
 		ccdPool.push_back(ccd.clone());
+		if (ccdPool.back()) {
+			ccdPool.back()->setCoordinateStream(i);
+		}
 		selectorPool.push_back(selector.clone());
 	}
 
@@ -92,6 +95,12 @@ void AbstractCrossValidationDriver::drive(
         errorStream << "Memory allocation error in multi-threaded cross validation driver";
         error->throwError(errorStream);
     }
+
+	// Keep the risk-set layouts of every fold's training and held-out weights and of the full data,
+	// so fold switches reuse them
+	for (auto element : ccdPool) {
+		element->setWeightPatternCount(2 * allArguments.crossValidation.fold + 1);
+	}
 	// End of multi-thread set-up
 
 	// Delegate to auto or grid loop
@@ -0,0 +1,83 @@
+/*
+ * ApproximateLeaveOutCrossValidationDriver.cpp
+ *
+ *  Grid search scored by approximate leave-one-out from a single fit per grid-point
+ */
+
+#include <iterator>
+#include <limits>
+
+#include "Types.h"
+#include "CyclicCoordinateDescent.h"
+#include "ApproximateLeaveOutCrossValidationDriver.h"
+
+namespace bsccs {
+
+ApproximateLeaveOutCrossValidationDriver::ApproximateLeaveOutCrossValidationDriver(
+            const CCDArguments& arguments,
+			loggers::ProgressLoggerPtr _logger,
+			loggers::ErrorHandlerPtr _error,
+			std::vector<double>* wtsExclude) : GridSearchCrossValidationDriver(arguments, _logger, _error, wtsExclude) {
+	// Do nothing
+}
+
+ApproximateLeaveOutCrossValidationDriver::~ApproximateLeaveOutCrossValidationDriver() {
+	// Do nothing
+}
+
+MaxPoint ApproximateLeaveOutCrossValidationDriver::doCrossValidationLoop(
+			CyclicCoordinateDescent& ccd,
+			AbstractSelector& /* selector */,
+			const CCDArguments& allArguments,
+			int nThreads,
+			std::vector<CyclicCoordinateDescent*>& /* ccdPool */,
+			std::vector<AbstractSelector*>& /* selectorPool */) {
+
+	// Every grid-point is fit once to all data; folds are replaced by one Newton step per left-out
+	// row (or stratum) from the full-data mode, so the grid is walked in order with warm starts
+	// and the threads go to each fit and its leave-out kernel instead of to folds
+	ccd.setWeights(NULL);
+	ccd.setThreadCount(nThreads);
+
+	for (int step = 0; step < gridSize; step++) {
+
+		double point = computeGridPoint(step);
+		ccd.setHyperprior(point);
+		if (allArguments.resetCoefficients) {
+			ccd.resetBeta();
+		}
+
+		std::ostringstream stream;
+		stream << "Running at " << ccd.getPriorInfo() << " ";
+		stream << "Grid-point #" << (step + 1) << " at ";
+		std::vector<double> hyperprior = ccd.getHyperprior();
+		std::copy(hyperprior.begin(), hyperprior.end(),
+			std::ostream_iterator<double>(stream, " "));
+		stream << "\tapproximate leave-one-out log like = ";
+
+		ccd.update(allArguments.modeFinding);
+
+		double value;
+		if (ccd.getUpdateReturnFlag() == SUCCESS) {
+			value = ccd.getApproximateLeaveOutLogLikelihood();
+			stream << value;
+		} else {
+			ccd.resetBeta(); // cold start for stability
+			value = std::numeric_limits<double>::quiet_NaN();
+			stream << "Not computed";
+		}
+		logger->writeLine(stream);
+
+		gridPoint.push_back(point);
+		gridValue.push_back(value);
+	}
+
+	double maxPoint;
+	double maxValue;
+	findMax(&maxPoint, &maxValue);
+
+	std::vector<double> point(1, maxPoint);
+	return MaxPoint{point, maxValue};
+}
+
+} // namespace
@@ -0,0 +1,37 @@
+/*
+ * ApproximateLeaveOutCrossValidationDriver.h
+ *
+ *  Grid search scored by approximate leave-one-out from a single fit per grid-point
+ */
+
+#ifndef APPROXIMATELEAVEOUTCROSSVALIDATIONDRIVER_H_
+#define APPROXIMATELEAVEOUTCROSSVALIDATIONDRIVER_H_
+
+#include "GridSearchCrossValidationDriver.h"
+
+namespace bsccs {
+
+class ApproximateLeaveOutCrossValidationDriver : public GridSearchCrossValidationDriver {
+public:
+	ApproximateLeaveOutCrossValidationDriver(
+            const CCDArguments& arguments,
+			loggers::ProgressLoggerPtr _logger,
+			loggers::ErrorHandlerPtr _error,
+			std::vector<double>* wtsExclude = NULL);
+
+	virtual ~ApproximateLeaveOutCrossValidationDriver();
+
+protected:
+
+	virtual MaxPoint doCrossValidationLoop(
+			CyclicCoordinateDescent& ccd,
+			AbstractSelector& selector,
+			const CCDArguments& arguments,
+			int nThreads,
+			std::vector<CyclicCoordinateDescent*>& ccdPool,
+			std::vector<AbstractSelector*>& selectorPool);
+};
+
+} // namespace
+
+#endif /* APPROXIMATELEAVEOUTCROSSVALIDATIONDRIVER_H_ */
@@ -12,6 +12,8 @@
 #include <cstdlib>
 #include <iterator>
 #include <algorithm>
+#include <limits>
+#include <map>
 
 #include "Types.h"
 #include "Thread.h"
@@ -91,6 +93,18 @@ MaxPoint AutoSearchCrossValidationDriver::doCrossValidationLoop(
 	bool globalFinished = false;
 	std::vector<double> savedOptimal;
 
+	// With more threads than folds, also evaluate the variances the search may ask for next
+	int batchSize = 1;
+	if (nDim == 1 && nThreads > arguments.foldToCompute) {
+	    bool privatePriors = true;
+	    for (size_t i = 1; i < ccdPool.size() && privatePriors; ++i) {
+	        privatePriors = ccdPool[i]->setPrivatePrior();
+	    }
+	    if (privatePriors) {
+	        batchSize = (nThreads + arguments.foldToCompute - 1) / arguments.foldToCompute;
+	    }
+	}
+
 	while (!globalFinished) {
 
 	    if (nDim > 1) {
@@ -105,42 +119,74 @@ MaxPoint AutoSearchCrossValidationDriver::doCrossValidationLoop(
 	        int step = 0;
 	        bool dimFinished = false;
 
+	        // Speculatively evaluated points that the search has not asked for yet
+	        std::map<double, std::pair<double, double>> evaluated;
+
 	        while (!dimFinished) {
 
-	            ccd.setHyperprior(dim, currentOptimal[dim]);
-	            selector.reseed();
+	            std::vector<double> candidates = searcher.batch(
+	                StepValue(true, currentOptimal[dim], 0.0), batchSize);
 
-	            std::vector<double> predLogLikelihood;
+	            std::vector<double> pointEstimates;
+	            std::vector<std::vector<double>> predLogLikelihood;
 
-	            // Newly re-located code
-	            double pointEstimate = doCrossValidationStep(ccd, selector, allArguments, step,
-                                                          nThreads, ccdPool, selectorPool,
-                                                          predLogLikelihood);
+	            if (candidates.size() == 1) {
+	                for (auto ccdTask : ccdPool) {
+	                    ccdTask->setHyperprior(dim, candidates[0]); // Some pool members may own their prior
+	                }
+	                selector.reseed();
 
-	            double stdDevEstimate = computeStDev(predLogLikelihood, pointEstimate);
+	                predLogLikelihood.resize(1);
 
-	            std::ostringstream stream;
-	            stream << "AvgPred = " << pointEstimate << " with stdev = " << stdDevEstimate << std::endl;
-	            searcher.tried(currentOptimal[dim], pointEstimate, stdDevEstimate);
-	            StepValue next = searcher.step();
-	            stream << "Completed at " << currentOptimal[dim] << std::endl;
-	            stream << "Next point at " << next.second << " with value " << next.expected << " and continue = " << next.first;
-	            logger->writeLine(stream);
+	                // Newly re-located code
+	                pointEstimates.push_back(doCrossValidationStep(ccd, selector, allArguments, step,
+                                                               nThreads, ccdPool, selectorPool,
+                                                               predLogLikelihood[0]));
+	            } else {
+	                pointEstimates = doCrossValidationBatch(allArguments, dim, candidates, step,
+                                                         nThreads, ccdPool, selectorPool,
+                                                         predLogLikelihood);
+	            }
 
-	            currentOptimal[dim] = next.second;
-	            currentOptimalValue = next.expected;
-	            if (!next.first) {
-	                dimFinished = true;
+	            for (size_t i = 0; i < candidates.size(); ++i) {
+	                evaluated[candidates[i]] = std::make_pair(pointEstimates[i],
+                                                          computeStDev(predLogLikelihood[i], pointEstimates[i]));
 	            }
-	            std::ostringstream stream1;
-	            stream1 << searcher;
-	            logger->writeLine(stream1);
-	            step++;
-	            if (step >= maxSteps) {
+
+	            // Replay the sequential search for as long as it asks for points already evaluated
+	            auto found = evaluated.find(currentOptimal[dim]);
+	            while (!dimFinished && found != evaluated.end()) {
+
+	                double pointEstimate = found->second.first;
+	                double stdDevEstimate = found->second.second;
+
 	                std::ostringstream stream;
-	                stream << "Max steps reached!";
+	                stream << "AvgPred = " << pointEstimate << " with stdev = " << stdDevEstimate << std::endl;
+	                searcher.tried(currentOptimal[dim], pointEstimate, stdDevEstimate);
+	                StepValue next = searcher.step();
+	                stream << "Completed at " << currentOptimal[dim] << std::endl;
+	                stream << "Next point at " << next.second << " with value " << next.expected << " and continue = " << next.first;
 	                logger->writeLine(stream);
-	                dimFinished = true;
+
+	                evaluated.erase(found);
+
+	                currentOptimal[dim] = next.second;
+	                currentOptimalValue = next.expected;
+	                if (!next.first) {
+	                    dimFinished = true;
+	                }
+	                std::ostringstream stream1;
+	                stream1 << searcher;
+	                logger->writeLine(stream1);
+	                step++;
+	                if (step >= maxSteps) {
+	                    std::ostringstream stream;
+	                    stream << "Max steps reached!";
+	                    logger->writeLine(stream);
+	                    dimFinished = true;
+	                }
+
+	                found = evaluated.find(currentOptimal[dim]);
 	            }
 	        }
 	    }
@@ -162,4 +208,107 @@ MaxPoint AutoSearchCrossValidationDriver::doCrossValidationLoop(
 	return MaxPoint{currentOptimal, currentOptimalValue};
 }
 
+std::vector<double> AutoSearchCrossValidationDriver::doCrossValidationBatch(
+			const CCDArguments& allArguments,
+			int dim,
+			const std::vector<double>& points,
+			int step,
+			int nThreads,
+			std::vector<CyclicCoordinateDescent*>& ccdPool,
+			std::vector<AbstractSelector*>& selectorPool,
+			std::vector<std::vector<double>>& predLogLikelihood) {
+
+    const auto& arguments = allArguments.crossValidation;
+    const bool coldStart = allArguments.resetCoefficients;
+    const int folds = arguments.foldToCompute;
+
+	predLogLikelihood.assign(points.size(), std::vector<double>(folds));
+
+	auto& weightsExclude = this->weightsExclude;
+	auto& logger = this->logger;
+
+	// Tasks are (point x fold), point-major
+	auto scheduler = TaskScheduler<decltype(boost::make_counting_iterator(0))>(
+		boost::make_counting_iterator(0),
+		boost::make_counting_iterator(static_cast<int>(points.size()) * folds),
+		nThreads);
+
+	auto oneTask = [&](int index) {
+
+		const int point = index / folds;
+		const int task = index % folds;
+
+		const auto uniqueId = scheduler.getThreadIndex(index);
+		auto ccdTask = ccdPool[uniqueId];
+		auto selectorTask = selectorPool[uniqueId];
+
+		// Bring selector up-to-date
+		selectorTask->reseed();
+		for (int i = 0; i <= task; ++i) {
+			if (i % arguments.fold == 0) {
+				selectorTask->permute();
+			}
+		}
+
+		const int fold = task % arguments.fold;
+
+		std::vector<double> weights; // Task-specific
+		selectorTask->getWeights(fold, weights);
+		std::vector<double> complement(weights);
+		selectorTask->getComplement(complement);
+		if (weightsExclude) {
+			for (size_t j = 0; j < weightsExclude->size(); ++j) {
+				if (weightsExclude->at(j) == 1.0) {
+					weights[j] = 0.0;
+					complement[j] = 0.0;
+				}
+			}
+		}
+		ccdTask->setWeights(&weights[0]);
+		ccdTask->setHyperprior(dim, points[point]);
+
+		std::ostringstream stream;
+		stream << "Running at " << ccdTask->getPriorInfo() << " ";
+		stream << "Grid-point #" << (step + 1) << "." << (point + 1) << " at ";
+		std::vector<double> hyperprior = ccdTask->getHyperprior();
+		std::copy(hyperprior.begin(), hyperprior.end(),
+			std::ostream_iterator<double>(stream, " "));
+		stream << "\tFold #" << (fold + 1)
+			   << " Rep #" << (task / arguments.fold + 1) << " pred log like = ";
+
+		if (coldStart) {
+			ccdTask->resetBeta();
+		}
+
+		ccdTask->update(allArguments.modeFinding);
+
+		if (ccdTask->getUpdateReturnFlag() == SUCCESS) {
+			double logLikelihood = ccdTask->getNewPredictiveLogLikelihood(&complement[0]);
+			stream << logLikelihood;
+			predLogLikelihood[point][task] = logLikelihood;
+		} else {
+			ccdTask->resetBeta(); // cold start for stability
+			stream << "Not computed";
+			predLogLikelihood[point][task] = std::numeric_limits<double>::quiet_NaN();
+		}
+
+		logger->writeLine(stream);
+	};
+
+	if (nThreads > 1) {
+		ccdPool[0]->getProgressLogger().setConcurrent(true);
+	}
+	scheduler.execute(oneTask);
+	if (nThreads > 1) {
+		ccdPool[0]->getProgressLogger().setConcurrent(false);
+		ccdPool[0]->getProgressLogger().flush();
+	}
+
+	std::vector<double> pointEstimates;
+	for (const auto& values : predLogLikelihood) {
+		pointEstimates.push_back(computePointEstimate(values));
+	}
+	return pointEstimates;
+}
+
 } // namespace
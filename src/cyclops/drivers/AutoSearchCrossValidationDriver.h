@@ -66,6 +66,17 @@ protected:
 			std::vector<CyclicCoordinateDescent*>& ccdPool,
 			std::vector<AbstractSelector*>& selectorPool);
 
+	// Evaluate several values of one hyperparameter concurrently; pool members must own their priors
+	std::vector<double> doCrossValidationBatch(
+			const CCDArguments& arguments,
+			int dim,
+			const std::vector<double>& points,
+			int step,
+			int nThreads,
+			std::vector<CyclicCoordinateDescent*>& ccdPool,
+			std::vector<AbstractSelector*>& selectorPool,
+			std::vector<std::vector<double>>& predLogLikelihood);
+
 // 	double doCrossValidationStep(
 // 			CyclicCoordinateDescent& ccd,
 // 			AbstractSelector& selector,
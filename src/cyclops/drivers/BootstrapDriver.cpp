@@ -13,8 +13,13 @@
 #include <cmath>
 #include <sstream>
 
+#include "boost/iterator/counting_iterator.hpp"
+
+#include "Types.h"
+#include "Thread.h"
 #include "BootstrapDriver.h"
-#include "AbstractSelector.h"
+#include "BootstrapSelector.h"
+#include "CyclicCoordinateDescent.h"
 
 namespace bsccs {
 
@@ -26,22 +31,12 @@ BootstrapDriver::BootstrapDriver(
 		loggers::ProgressLoggerPtr _logger,
 		loggers::ErrorHandlerPtr _error
 		) : AbstractDriver(_logger, _error), replicates(inReplicates), modelData(inModelData),
-		J(inModelData->getNumberOfCovariates()) {
-
-	// Set-up storage for bootstrap estimates
-	estimates.resize(J);
-//	int count = 0;
-	for (rarrayIterator it = estimates.begin(); it != estimates.end(); ++it) {
-		*it = new rvector();
-	}
+		J(inModelData->getNumberOfCovariates()), summaries(J) {
+	// Do nothing
 }
 
 BootstrapDriver::~BootstrapDriver() {
-	for (rarrayIterator it = estimates.begin(); it != estimates.end(); ++it) {
-		if (*it) {
-			delete *it;
-		}
-	}
+	// Do nothing
 }
 
 void BootstrapDriver::drive(
@@ -49,25 +44,127 @@ void BootstrapDriver::drive(
 		AbstractSelector& selector,
 		const CCDArguments& arguments) {
 
-	// TODO Make sure that selector is type-of BootstrapSelector
-	std::vector<double> weights;
+	auto bootstrapSelector = dynamic_cast<BootstrapSelector*>(&selector);
+	if (bootstrapSelector == nullptr) {
+		std::ostringstream stream;
+		stream << "Bootstrap estimation requires a bootstrap selector";
+		error->throwError(stream);
+	}
+
+	// Keep raw draws only when reported, and only for the requested covariates if any
+	rawIndices.clear();
+	if (arguments.reportRawEstimates) {
+		if (arguments.rawEstimates.empty()) {
+			for (int j = 0; j < J; ++j) {
+				rawIndices.push_back(j);
+			}
+		} else {
+			for (auto id : arguments.rawEstimates) {
+				int index = modelData->getColumnIndexByName(id);
+				if (index == -1) {
+					std::ostringstream stream;
+					stream << "Variable " << id << " not found.";
+					error->throwError(stream);
+				}
+				rawIndices.push_back(index);
+			}
+		}
+	}
+	rawEstimates.assign(rawIndices.size(), std::vector<double>());
+
+	int nThreads = (arguments.threads == -1) ?
+		bsccs::thread::hardware_concurrency() :
+		arguments.threads;
+	nThreads = std::max(1, std::min(nThreads, replicates));
+
+	std::vector<CyclicCoordinateDescent*> ccdPool(1, &ccd);
+	std::vector<BootstrapSelector*> selectorPool(1, bootstrapSelector);
+	for (int i = 1; i < nThreads; ++i) {
+		ccdPool.push_back(ccd.clone());
+		if (ccdPool.back()) {
+			ccdPool.back()->setCoordinateStream(i);
+		}
+		selectorPool.push_back(static_cast<BootstrapSelector*>(bootstrapSelector->clone()));
+	}
 
-	for (int step = 0; step < replicates; step++) {
-		selector.permute();
-		selector.getWeights(0, weights);
-		ccd.setWeights(&weights[0]);
+	bool allocationError = false;
+	for (int i = 0; i < nThreads; ++i) {
+		if (ccdPool[i] == nullptr || selectorPool[i] == nullptr) {
+			allocationError = true;
+		}
+	}
+	if (allocationError) {
+		std::ostringstream stream;
+		stream << "Memory allocation error in multi-threaded bootstrap driver";
+		error->throwError(stream);
+	}
 
-        std::ostringstream stream;
-		stream << std::endl << "Running replicate #" << (step + 1);
-		logger->writeLine(stream);
-		// Run CCD using a warm start
-		ccd.update(arguments.modeFinding);
+	// Per-thread draws of the current round; only non-zero estimates are kept
+	std::vector<std::vector<std::pair<int,double>>> nonZero(nThreads);
+	std::vector<std::vector<double>> raw(nThreads);
 
-		// Store point estimates
-		for (int j = 0; j < J; ++j) {
-			estimates[j]->push_back(ccd.getBeta(j));
+	if (nThreads > 1) {
+		ccd.getProgressLogger().setConcurrent(true);
+	}
+
+	// Rounds of one replicate per thread, summarised in replicate order; each thread warm-starts from its last fit
+	for (int start = 0; start < replicates; start += nThreads) {
+		const int end = std::min(start + nThreads, replicates);
+
+		auto scheduler = TaskScheduler<decltype(boost::make_counting_iterator(0))>(
+			boost::make_counting_iterator(start),
+			boost::make_counting_iterator(end),
+			nThreads);
+
+		scheduler.execute([&](int step) {
+			const int slot = step - start;
+			auto ccdTask = ccdPool[slot];
+			auto selectorTask = selectorPool[slot];
+
+			std::vector<double> weights;
+			selectorTask->permute(step);
+			selectorTask->getWeights(0, weights);
+			ccdTask->setWeights(&weights[0]);
+
+			std::ostringstream stream;
+			stream << std::endl << "Running replicate #" << (step + 1);
+			logger->writeLine(stream);
+			ccdTask->update(arguments.modeFinding);
+
+			auto& estimates = nonZero[slot];
+			estimates.clear();
+			for (int j = 0; j < J; ++j) {
+				const double beta = ccdTask->getBeta(j);
+				if (beta != 0.0) {
+					estimates.emplace_back(j, beta);
+				}
+			}
+			auto& draws = raw[slot];
+			draws.clear();
+			for (int index : rawIndices) {
+				draws.push_back(ccdTask->getBeta(index));
+			}
+		});
+
+		for (int slot = 0; slot < end - start; ++slot) {
+			for (const auto& estimate : nonZero[slot]) {
+				summaries[estimate.first].addNonZero(estimate.second);
+			}
+			for (size_t i = 0; i < rawIndices.size(); ++i) {
+				rawEstimates[i].push_back(raw[slot][i]);
+			}
 		}
 	}
+
+	if (nThreads > 1) {
+		ccd.getProgressLogger().setConcurrent(false);
+		ccd.getProgressLogger().flush();
+	}
+
+	for (int i = 1; i < nThreads; ++i) {
+		delete ccdPool[i];
+		delete selectorPool[i];
+	}
 }
 
 void BootstrapDriver::logResults(const CCDArguments& arguments) {
@@ -93,37 +190,25 @@ void BootstrapDriver::logResults(const CCDArguments& arguments, std::vector<doub
 				"bs_upper" << sep << "bs_prob0" << endl;
 	}
 
-	for (int j = 0; j < J; ++j) {
-		outLog << modelData->getColumnLabel(j) <<
-			sep << conditionId << sep;
-		if (arguments.reportRawEstimates) {
+	if (arguments.reportRawEstimates) {
+		for (size_t i = 0; i < rawIndices.size(); ++i) {
+			outLog << modelData->getColumnLabel(rawIndices[i]) <<
+				sep << conditionId << sep;
 			ostream_iterator<double> output(outLog, sep.c_str());
-			copy(estimates[j]->begin(), estimates[j]->end(), output);
+			copy(rawEstimates[i].begin(), rawEstimates[i].end(), output);
 			outLog << endl;
-		} else {
-			double mean = 0.0;
-			double var = 0.0;
-			double prob0 = 0.0;
-			for (rvector::iterator it = estimates[j]->begin(); it != estimates[j]->end(); ++it) {
-				mean += *it;
-				var += *it * *it;
-				if (*it == 0.0) {
-					prob0 += 1.0;
-				}
-			}
-
-			double size = static_cast<double>(estimates[j]->size());
-			mean /= size;
-			var = (var / size) - (mean * mean);
-			prob0 /= size;
-
-			sort(estimates[j]->begin(), estimates[j]->end());
-			int offsetLower = static_cast<int>(size * 0.025);
-			int offsetUpper = static_cast<int>(size * 0.975);
-
-			double lower = *(estimates[j]->begin() + offsetLower);
-			double upper = *(estimates[j]->begin() + offsetUpper);
-
+		}
+	} else {
+		for (int j = 0; j < J; ++j) {
+			auto& summary = summaries[j];
+			double mean = summary.getMean(replicates);
+			double var = summary.getVariance(replicates);
+			double prob0 = summary.getProbabilityZero(replicates);
+			double lower = summary.getQuantile(0.025, replicates);
+			double upper = summary.getQuantile(0.975, replicates);
+
+			outLog << modelData->getColumnLabel(j) <<
+				sep << conditionId << sep;
 			outLog << savedBeta[j] << sep;
 			outLog << std::sqrt(var) << sep << mean << sep << lower << sep << upper << sep << prob0 << endl;
 		}
@@ -11,14 +11,11 @@
 #include <vector>
 
 #include "AbstractDriver.h"
+#include "BootstrapStatistics.h"
 #include "ModelData.h"
 
 namespace bsccs {
 
-typedef std::vector<real> rvector;
-typedef std::vector<rvector*> rarray;
-typedef	rarray::iterator rarrayIterator;
-
 class BootstrapDriver : public AbstractDriver {
 public:
 	BootstrapDriver(
@@ -43,7 +40,9 @@ private:
 	const int replicates;
 	AbstractModelData* modelData;
 	const int J;
-	rarray estimates;
+	std::vector<CoefficientSummary> summaries; // Streaming, replaces storing every draw
+	std::vector<int> rawIndices;
+	std::vector<std::vector<double>> rawEstimates; // Only for rawIndices
 };
 
 } // namespace
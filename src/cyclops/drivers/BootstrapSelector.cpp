@@ -70,6 +70,12 @@ void BootstrapSelector::permute() {
 	}
 }
 
+void BootstrapSelector::permute(int replicate) {
+	std::seed_seq stream{static_cast<long>(seed), static_cast<long>(replicate)};
+	prng.seed(stream);
+	permute();
+}
+
 void BootstrapSelector::getWeights(int batch, std::vector<double>& weights) {
 	if (weights.size() != K) {
 		weights.resize(K);
@@ -29,6 +29,9 @@ public:
 
 	virtual void permute();
 
+	// Draw replicate from its own random stream, independent of the order replicates are run
+	void permute(int replicate);
+
 	virtual void getWeights(int batch, std::vector<double>& weights);
 
 	virtual void getComplement(std::vector<double>& weights);
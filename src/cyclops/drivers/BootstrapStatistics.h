@@ -0,0 +1,168 @@
+/*
+ * BootstrapStatistics.h
+ *
+ *  Streaming summaries of bootstrap replicates
+ */
+
+#ifndef BOOTSTRAPSTATISTICS_H_
+#define BOOTSTRAPSTATISTICS_H_
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace bsccs {
+
+// Merging t-digest (Dunning & Ertl); small centroids in the tails keep extreme quantiles accurate
+class QuantileSketch {
+public:
+	explicit QuantileSketch(double compression = 100.0) : compression(compression), total(0.0) { }
+
+	void add(double x) {
+		buffer.push_back(Centroid{x, 1.0});
+		if (buffer.size() >= static_cast<size_t>(5 * compression)) {
+			compress();
+		}
+	}
+
+	// Value at (0-based) position rank of the sorted draws; exact while every centroid holds a single draw
+	double valueAtRank(double rank) {
+		compress();
+		if (centroids.empty()) {
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+		const double index = std::max(0.0, std::min(rank, total - 1.0));
+
+		double cumulative = 0.0;
+		for (size_t i = 0; i < centroids.size(); ++i) {
+			const Centroid& c = centroids[i];
+			if (index < cumulative + c.weight) {
+				if (c.weight == 1.0) {
+					return c.mean;
+				}
+				// Interpolate between neighbouring centroid centres
+				const double center = cumulative + c.weight / 2.0;
+				if (index < center) {
+					const double left = (i == 0) ? minimum : centroids[i - 1].mean;
+					const double leftCenter = (i == 0) ? 0.0 : cumulative - centroids[i - 1].weight / 2.0;
+					return left + (c.mean - left) * (index - leftCenter) / (center - leftCenter);
+				} else {
+					const double right = (i + 1 == centroids.size()) ? maximum : centroids[i + 1].mean;
+					const double rightCenter = (i + 1 == centroids.size()) ? total : cumulative + c.weight + centroids[i + 1].weight / 2.0;
+					return c.mean + (right - c.mean) * (index - center) / (rightCenter - center);
+				}
+			}
+			cumulative += c.weight;
+		}
+		return maximum;
+	}
+
+private:
+	struct Centroid {
+		double mean;
+		double weight;
+	};
+
+	double scale(double q) const {
+		return compression / (4.0 * std::acos(0.0)) * std::asin(2.0 * q - 1.0);
+	}
+
+	void compress() {
+		if (buffer.empty()) {
+			return;
+		}
+		buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+		std::sort(buffer.begin(), buffer.end(), [](const Centroid& lhs, const Centroid& rhs) {
+			return lhs.mean < rhs.mean;
+		});
+
+		total = 0.0;
+		for (const auto& c : buffer) {
+			total += c.weight;
+		}
+		minimum = (centroids.empty() || buffer.front().mean < minimum) ? buffer.front().mean : minimum;
+		maximum = (centroids.empty() || buffer.back().mean > maximum) ? buffer.back().mean : maximum;
+
+		centroids.clear();
+		Centroid current = buffer.front();
+		double weightSoFar = 0.0;
+		for (size_t i = 1; i < buffer.size(); ++i) {
+			const Centroid& next = buffer[i];
+			const double q0 = weightSoFar / total;
+			const double q2 = (weightSoFar + current.weight + next.weight) / total;
+			if (scale(q2) - scale(q0) <= 1.0) {
+				current.mean += (next.mean - current.mean) * next.weight / (current.weight + next.weight);
+				current.weight += next.weight;
+			} else {
+				weightSoFar += current.weight;
+				centroids.push_back(current);
+				current = next;
+			}
+		}
+		centroids.push_back(current);
+		buffer.clear();
+	}
+
+	double compression;
+	double total;
+	double minimum;
+	double maximum;
+	std::vector<Centroid> centroids;
+	std::vector<Centroid> buffer;
+};
+
+// Running moments and quantiles of one coefficient; zero draws (common under L1 priors) are only counted
+class CoefficientSummary {
+public:
+	CoefficientSummary() : count(0), negatives(0), mean(0.0), m2(0.0) { }
+
+	void addNonZero(double x) {
+		++count;
+		if (x < 0.0) {
+			++negatives;
+		}
+		const double delta = x - mean;
+		mean += delta / count;
+		m2 += delta * (x - mean);
+		sketch.add(x);
+	}
+
+	// Summaries over all replicates, counting draws never added as zero
+	double getMean(long replicates) const {
+		return mean * count / replicates;
+	}
+
+	double getVariance(long replicates) const {
+		const double zeros = static_cast<double>(replicates - count);
+		return (m2 + mean * mean * count * zeros / replicates) / replicates;
+	}
+
+	double getProbabilityZero(long replicates) const {
+		return static_cast<double>(replicates - count) / replicates;
+	}
+
+	// Draw at position floor(q * replicates) of the sorted replicates
+	double getQuantile(double q, long replicates) {
+		const long index = static_cast<long>(replicates * q);
+		const long zeros = replicates - count;
+		if (index < negatives) {
+			return sketch.valueAtRank(index);
+		} else if (index < negatives + zeros) {
+			return 0.0;
+		} else {
+			return sketch.valueAtRank(index - zeros);
+		}
+	}
+
+private:
+	long count;
+	long negatives;
+	double mean;
+	double m2;
+	QuantileSketch sketch;
+};
+
+} // namespace
+
+#endif /* BOOTSTRAPSTATISTICS_H_ */
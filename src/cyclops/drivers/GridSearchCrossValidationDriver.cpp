@@ -10,7 +10,15 @@
 #include <numeric>
 #include <math.h>
 #include <cstdlib>
+#include <algorithm>
+#include <iterator>
+#include <limits>
 
+#include "boost/iterator/counting_iterator.hpp"
+
+#include "Types.h"
+#include "Thread.h"
+#include "CyclicCoordinateDescent.h"
 #include "GridSearchCrossValidationDriver.h"
 
 namespace bsccs {
@@ -103,21 +111,39 @@ MaxPoint GridSearchCrossValidationDriver::doCrossValidationLoop(
 
     const auto& arguments = allArguments.crossValidation;
 
-// 	std::vector<double> weights;
-	for (int step = 0; step < gridSize; step++) {
+	// Fits at different grid-points may only run concurrently when no hyperparameters are shared
+	bool privatePriors = true;
+	for (size_t i = 1; i < ccdPool.size() && privatePriors; ++i) {
+		privatePriors = ccdPool[i]->setPrivatePrior();
+	}
 
-		std::vector<double> predLogLikelihood;
-		double point = computeGridPoint(step);
-		ccd.setHyperprior(point);
-		selector.reseed();
+	if (arguments.gridLanes > 1 && ccd.getSupportsLanes(allArguments.modeFinding)) {
 
-		double pointEstimate = doCrossValidationStep(ccd, selector, allArguments, step,
-			nThreads, ccdPool, selectorPool,
-			predLogLikelihood);
-		double value = pointEstimate / (double(arguments.foldToCompute) / double(arguments.fold));
+		doGridByFoldLanesLoop(allArguments, nThreads, ccdPool, selectorPool);
 
-		gridPoint.push_back(point);
-		gridValue.push_back(value);
+	} else if (privatePriors) {
+
+		doGridByFoldLoop(allArguments, nThreads, ccdPool, selectorPool);
+
+	} else {
+
+		for (int step = 0; step < gridSize; step++) {
+
+			std::vector<double> predLogLikelihood;
+			double point = computeGridPoint(step);
+			for (auto ccdTask : ccdPool) {
+				ccdTask->setHyperprior(point); // Some pool members may already own their prior
+			}
+			selector.reseed();
+
+			double pointEstimate = doCrossValidationStep(ccd, selector, allArguments, step,
+				nThreads, ccdPool, selectorPool,
+				predLogLikelihood);
+			double value = pointEstimate / (double(arguments.foldToCompute) / double(arguments.fold));
+
+			gridPoint.push_back(point);
+			gridValue.push_back(value);
+		}
 	}
 
 	// Report results
@@ -140,6 +166,309 @@ MaxPoint GridSearchCrossValidationDriver::doCrossValidationLoop(
 }
 
 
+void GridSearchCrossValidationDriver::doGridByFoldLoop(
+			const CCDArguments& allArguments,
+			int nThreads,
+			std::vector<CyclicCoordinateDescent*>& ccdPool,
+			std::vector<AbstractSelector*>& selectorPool) {
+
+	const auto& arguments = allArguments.crossValidation;
+	const bool coldStart = allArguments.resetCoefficients;
+	const int taskCount = arguments.foldToCompute;
+
+	std::vector<double> points(gridSize);
+	for (int step = 0; step < gridSize; ++step) {
+		points[step] = computeGridPoint(step);
+	}
+
+	// Each fold walks the grid in penalty order.  Every stride-th grid-point (anchor) is fit first in one
+	// warm-started chain per fold; the points between anchors are then fit as short chains that start from
+	// the preceding anchor.  The split depends only on gridSize, so results do not depend on nThreads.
+	const int stride = coldStart ? 1 :
+		std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(gridSize)))));
+
+	struct Chain {
+		int task;
+		int anchor; // -1 for a cold start
+		std::vector<int> steps;
+	};
+
+	std::vector<Chain> anchorChains;
+	std::vector<Chain> fillChains;
+
+	for (int task = 0; task < taskCount; ++task) {
+		if (coldStart) {
+			for (int step = 0; step < gridSize; ++step) {
+				anchorChains.push_back(Chain{task, -1, std::vector<int>(1, step)});
+			}
+		} else {
+			Chain chain{task, -1, std::vector<int>()};
+			for (int anchor = 0; anchor < gridSize; anchor += stride) {
+				chain.steps.push_back(anchor);
+
+				Chain fill{task, anchor, std::vector<int>()};
+				for (int step = anchor + 1; step < std::min(anchor + stride, gridSize); ++step) {
+					fill.steps.push_back(step);
+				}
+				if (!fill.steps.empty()) {
+					fillChains.push_back(fill);
+				}
+			}
+			anchorChains.push_back(chain);
+		}
+	}
+
+	// Anchor estimates are kept sparse; only non-zero coefficients are stored
+	typedef std::vector<std::pair<int,double>> SparseBeta;
+	std::vector<SparseBeta> anchorBeta(taskCount * gridSize);
+
+	std::vector<std::vector<double>> predLogLikelihood(gridSize, std::vector<double>(taskCount));
+
+	auto& weightsExclude = this->weightsExclude;
+	auto& logger = this->logger;
+
+	auto runChains = [&](const std::vector<Chain>& chains, bool saveBeta) {
+
+		auto scheduler = TaskScheduler<decltype(boost::make_counting_iterator(0))>(
+			boost::make_counting_iterator(0),
+			boost::make_counting_iterator(static_cast<int>(chains.size())),
+			nThreads);
+
+		auto oneChain = [&](int index) {
+
+			const Chain& chain = chains[index];
+			const auto uniqueId = scheduler.getThreadIndex(index);
+			auto ccdTask = ccdPool[uniqueId];
+			auto selectorTask = selectorPool[uniqueId];
+
+			// Replay the selector so this chain sees the same fold regardless of scheduling
+			selectorTask->reseed();
+			for (int i = 0; i <= chain.task; ++i) {
+				if (i % arguments.fold == 0) {
+					selectorTask->permute();
+				}
+			}
+
+			const int fold = chain.task % arguments.fold;
+
+			std::vector<double> weights;
+			selectorTask->getWeights(fold, weights);
+			std::vector<double> complement(weights);
+			selectorTask->getComplement(complement);
+			if (weightsExclude) {
+				for (size_t j = 0; j < weightsExclude->size(); ++j) {
+					if (weightsExclude->at(j) == 1.0) {
+						weights[j] = 0.0;
+						complement[j] = 0.0;
+					}
+				}
+			}
+			ccdTask->setWeights(&weights[0]);
+
+			const int J = ccdTask->getBetaSize();
+			if (chain.anchor < 0) {
+				ccdTask->resetBeta();
+			} else {
+				std::vector<double> beta(J, 0.0);
+				for (const auto& entry : anchorBeta[chain.task * gridSize + chain.anchor]) {
+					beta[entry.first] = entry.second;
+				}
+				ccdTask->setBeta(beta);
+			}
+
+			for (int step : chain.steps) {
+
+				ccdTask->setHyperprior(points[step]);
+				if (coldStart) {
+					ccdTask->resetBeta();
+				}
+
+				std::ostringstream stream;
+				stream << "Running at " << ccdTask->getPriorInfo() << " ";
+				stream << "Grid-point #" << (step + 1) << " at ";
+				std::vector<double> hyperprior = ccdTask->getHyperprior();
+				std::copy(hyperprior.begin(), hyperprior.end(),
+					std::ostream_iterator<double>(stream, " "));
+				stream << "\tFold #" << (fold + 1)
+					   << " Rep #" << (chain.task / arguments.fold + 1) << " pred log like = ";
+
+				ccdTask->update(allArguments.modeFinding);
+
+				if (ccdTask->getUpdateReturnFlag() == SUCCESS) {
+					double logLikelihood = ccdTask->getNewPredictiveLogLikelihood(&complement[0]);
+					stream << logLikelihood;
+					predLogLikelihood[step][chain.task] = logLikelihood;
+				} else {
+					ccdTask->resetBeta(); // cold start for stability
+					stream << "Not computed";
+					predLogLikelihood[step][chain.task] = std::numeric_limits<double>::quiet_NaN();
+				}
+
+				if (saveBeta) {
+					SparseBeta& saved = anchorBeta[chain.task * gridSize + step];
+					saved.clear();
+					for (int j = 0; j < J; ++j) {
+						const double value = ccdTask->getBeta(j);
+						if (value != 0.0) {
+							saved.emplace_back(j, value);
+						}
+					}
+				}
+
+				logger->writeLine(stream);
+			}
+		};
+
+		if (nThreads > 1) {
+			ccdPool[0]->getProgressLogger().setConcurrent(true);
+		}
+		scheduler.execute(oneChain);
+		if (nThreads > 1) {
+			ccdPool[0]->getProgressLogger().setConcurrent(false);
+			ccdPool[0]->getProgressLogger().flush();
+		}
+	};
+
+	runChains(anchorChains, !coldStart);
+	if (!fillChains.empty()) {
+		runChains(fillChains, false);
+	}
+
+	for (int step = 0; step < gridSize; ++step) {
+		double pointEstimate = computePointEstimate(predLogLikelihood[step]);
+		double value = pointEstimate / (double(arguments.foldToCompute) / double(arguments.fold));
+
+		gridPoint.push_back(points[step]);
+		gridValue.push_back(value);
+	}
+}
+
+void GridSearchCrossValidationDriver::doGridByFoldLanesLoop(
+			const CCDArguments& allArguments,
+			int nThreads,
+			std::vector<CyclicCoordinateDescent*>& ccdPool,
+			std::vector<AbstractSelector*>& selectorPool) {
+
+	const auto& arguments = allArguments.crossValidation;
+	const bool coldStart = allArguments.resetCoefficients;
+	const int taskCount = arguments.foldToCompute;
+	const int lanes = std::min(arguments.gridLanes, gridSize);
+
+	std::vector<double> points(gridSize);
+	for (int step = 0; step < gridSize; ++step) {
+		points[step] = computeGridPoint(step);
+	}
+
+	std::vector<std::vector<double>> predLogLikelihood(gridSize, std::vector<double>(taskCount));
+
+	auto& weightsExclude = this->weightsExclude;
+	auto& logger = this->logger;
+
+	auto scheduler = TaskScheduler<decltype(boost::make_counting_iterator(0))>(
+		boost::make_counting_iterator(0),
+		boost::make_counting_iterator(taskCount),
+		nThreads);
+
+	auto oneTask = [&](int task) {
+
+		const auto uniqueId = scheduler.getThreadIndex(task);
+		auto ccdTask = ccdPool[uniqueId];
+		auto selectorTask = selectorPool[uniqueId];
+
+		// Replay the selector so this task sees the same fold regardless of scheduling
+		selectorTask->reseed();
+		for (int i = 0; i <= task; ++i) {
+			if (i % arguments.fold == 0) {
+				selectorTask->permute();
+			}
+		}
+
+		const int fold = task % arguments.fold;
+
+		std::vector<double> weights;
+		selectorTask->getWeights(fold, weights);
+		std::vector<double> complement(weights);
+		selectorTask->getComplement(complement);
+		if (weightsExclude) {
+			for (size_t j = 0; j < weightsExclude->size(); ++j) {
+				if (weightsExclude->at(j) == 1.0) {
+					weights[j] = 0.0;
+					complement[j] = 0.0;
+				}
+			}
+		}
+		ccdTask->setWeights(&weights[0]);
+		ccdTask->resetBeta();
+
+		const int J = ccdTask->getBetaSize();
+		std::vector<double> start(J);
+		for (int j = 0; j < J; ++j) {
+			start[j] = ccdTask->getBeta(j);
+		}
+
+		// Grid-points run in penalty order; each block of lanes warm-starts from the last estimate of the previous
+		for (int first = 0; first < gridSize; first += lanes) {
+			const int count = std::min(lanes, gridSize - first);
+			const std::vector<double> variances(points.begin() + first, points.begin() + first + count);
+
+			std::vector<double> beta(J * count);
+			for (int j = 0; j < J; ++j) {
+				std::fill(beta.begin() + j * count, beta.begin() + (j + 1) * count, start[j]);
+			}
+
+			std::vector<UpdateReturnFlags> returnFlags;
+			ccdTask->updateLanes(allArguments.modeFinding, variances, beta, returnFlags);
+
+			std::vector<double> laneBeta(J);
+			for (int l = 0; l < count; ++l) {
+				const int step = first + l;
+
+				std::ostringstream stream;
+				stream << "Running lane " << (l + 1) << " of " << count << " ";
+				stream << "Grid-point #" << (step + 1) << " at " << points[step];
+				stream << "\tFold #" << (fold + 1)
+					   << " Rep #" << (task / arguments.fold + 1) << " pred log like = ";
+
+				if (returnFlags[l] == SUCCESS) {
+					for (int j = 0; j < J; ++j) {
+						laneBeta[j] = beta[j * count + l];
+					}
+					ccdTask->setBeta(laneBeta);
+					double logLikelihood = ccdTask->getNewPredictiveLogLikelihood(&complement[0]);
+					stream << logLikelihood;
+					predLogLikelihood[step][task] = logLikelihood;
+
+					if (!coldStart) {
+						start = laneBeta;
+					}
+				} else {
+					stream << "Not computed";
+					predLogLikelihood[step][task] = std::numeric_limits<double>::quiet_NaN();
+				}
+
+				logger->writeLine(stream);
+			}
+		}
+	};
+
+	if (nThreads > 1) {
+		ccdPool[0]->getProgressLogger().setConcurrent(true);
+	}
+	scheduler.execute(oneTask);
+	if (nThreads > 1) {
+		ccdPool[0]->getProgressLogger().setConcurrent(false);
+		ccdPool[0]->getProgressLogger().flush();
+	}
+
+	for (int step = 0; step < gridSize; ++step) {
+		double pointEstimate = computePointEstimate(predLogLikelihood[step]);
+		double value = pointEstimate / (double(arguments.foldToCompute) / double(arguments.fold));
+
+		gridPoint.push_back(points[step]);
+		gridValue.push_back(value);
+	}
+}
+
 // void GridSearchCrossValidationDriver::drive(
 // 		CyclicCoordinateDescent& ccd,
 // 		AbstractSelector& selector,
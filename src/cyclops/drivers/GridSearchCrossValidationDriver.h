@@ -46,6 +46,13 @@ protected:
 			std::vector<CyclicCoordinateDescent*>& ccdPool,
 			std::vector<AbstractSelector*>& selectorPool);
 
+	// Parallel over (grid-point x fold); requires each pool member to own its hyperparameters
+	void doGridByFoldLoop(
+			const CCDArguments& arguments,
+			int nThreads,
+			std::vector<CyclicCoordinateDescent*>& ccdPool,
+			std::vector<AbstractSelector*>& selectorPool);
+
 // 	double doCrossValidationStep(
 // 			CyclicCoordinateDescent& ccd,
 // 			AbstractSelector& selector,
@@ -59,6 +66,13 @@ protected:
 
 //	double computePointEstimate(const std::vector<double>& value);
 
+	// Parallel over folds; consecutive grid-points are fit together as lanes of one model
+	void doGridByFoldLanesLoop(
+			const CCDArguments& arguments,
+			int nThreads,
+			std::vector<CyclicCoordinateDescent*>& ccdPool,
+			std::vector<AbstractSelector*>& selectorPool);
+
 	void findMax(double* maxPoint, double* maxValue);
 
 	std::vector<double> gridPoint;
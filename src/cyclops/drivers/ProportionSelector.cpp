@@ -6,8 +6,10 @@
  */
 
 #include <cstdlib>
+#include <cmath>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 
 #include "ProportionSelector.h"
 
@@ -21,10 +23,12 @@ ProportionSelector::ProportionSelector(
 	    loggers::ProgressLoggerPtr _logger,
 		loggers::ErrorHandlerPtr _error) : AbstractSelector(inIds, inType, inSeed, _logger, _error), total(inTotal) {
 
-    std::ostringstream stream;
-	stream << "Performing partial estimation with " << total
-		<< " data lines.";
-	logger->writeLine(stream);
+	if (total > 0) {
+		std::ostringstream stream;
+		stream << "Performing partial estimation with " << total
+			<< " data lines.";
+		logger->writeLine(stream);
+	}
 
 //	permute();
 }
@@ -39,17 +43,23 @@ AbstractSelector* ProportionSelector::clone() const {
 }
 
 void ProportionSelector::permute() {
-//	selectedSet.clear();
-//
-//	if (type == SUBJECT) {
-//		for (int i = 0; i < total; i++) {
-//			selectedSet.insert(i);
-//		}
-//	} else {
-        std::ostringstream stream;
-        stream <<  "ProportionSelector::permute is not yet implemented.";
-        error->throwError(stream);
-//	}
+	permutation.resize(N);
+	for (size_t i = 0; i < N; ++i) {
+		permutation[i] = i;
+	}
+	if (!deterministic) {
+		std::shuffle(permutation.begin(), permutation.end(), prng);
+	}
+}
+
+void ProportionSelector::setProportion(double proportion) {
+	if (permutation.empty()) {
+		std::ostringstream stream;
+		stream << "ProportionSelector::permute must precede setProportion.";
+		error->throwError(stream);
+	}
+	total = std::max(1, static_cast<int>(std::ceil(proportion * N)));
+	total = std::min(total, static_cast<int>(N));
 }
 
 void ProportionSelector::getWeights(int batch, std::vector<double>& weights) {
@@ -58,7 +68,23 @@ void ProportionSelector::getWeights(int batch, std::vector<double>& weights) {
 	}
 
 	std::fill(weights.begin(), weights.end(), 0.0);
-	std::fill(weights.begin(), weights.begin() + total, 1.0);
+	if (permutation.empty()) { // First rows
+		std::fill(weights.begin(), weights.begin() + total, 1.0);
+	} else if (type == SelectorType::BY_PID) {
+		std::vector<bool> selected(N, false);
+		for (int i = 0; i < total; ++i) {
+			selected[permutation[i]] = true;
+		}
+		for (size_t k = 0; k < K; ++k) {
+			if (selected[ids[k]]) {
+				weights[k] = 1.0;
+			}
+		}
+	} else { // SelectorType::BY_ROW
+		for (int i = 0; i < total; ++i) {
+			weights[permutation[i]] = 1.0;
+		}
+	}
 }
 
 void ProportionSelector::getComplement(std::vector<double>& weights) {
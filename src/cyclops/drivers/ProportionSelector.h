@@ -35,8 +35,12 @@ public:
 	
 	AbstractSelector* clone() const;
 
+	// After permute(), selects this proportion of randomly ordered units (pids or rows); selections are nested
+	void setProportion(double proportion);
+
 private:
 	std::multiset<int> selectedSet;
+	std::vector<int> permutation;
 
 	int total;
 
@@ -150,7 +150,7 @@ AbstractModelSpecifics* AbstractModelSpecifics::factory(const ModelType modelTyp
 AbstractModelSpecifics::AbstractModelSpecifics(const AbstractModelData& input)
 	: hPidOriginal(input.getPidVectorRef()), hPid(const_cast<int*>(hPidOriginal.data())),
       hPidSize(hPidOriginal.size()),
-      boundType(MmBoundType::METHOD_2) {
+      boundType(MmBoundType::METHOD_2), threadCount(1) {
 
 	// Do nothing
 }
@@ -63,16 +63,65 @@ public:
 
 	virtual void setWeights(double* inWeights, bool useCrossValidation) = 0; // pure virtual
 
+	void setThreadCount(int threads) { threadCount = threads; } // For kernels without a per-call count
+
 	virtual void computeGradientAndHessian(int index, double *ogradient,
 			double *ohessian, bool useWeights) = 0; // pure virtual
 
 	virtual void computeMMGradientAndHessian(std::vector<GradientHessian>& gh, const std::vector<bool>& fixBeta, bool useWeights) = 0; // pure virtual
 
+	virtual void computeGradient(std::vector<double>& gradient, const std::vector<bool>& fixBeta, bool useWeights, int threads) = 0; // pure virtual
+
 	virtual void computeNumeratorForGradient(int index, bool useWeights) = 0; // pure virtual
 
+	virtual void setGramThreshold(int threshold) = 0; // pure virtual
+
+	virtual void setCrossTermCacheSize(size_t bytes) = 0; // pure virtual
+
+	virtual CacheStatistics getCrossTermCacheStatistics() const = 0; // pure virtual
+
+	// Number of zero-weight patterns (e.g. folds) whose risk-set layouts are kept for reuse
+	virtual void setWeightPatternCount(int count) = 0; // pure virtual
+
+	virtual bool setQuadraticApproximation(bool approximate, bool useWeights) = 0; // pure virtual
+
+	virtual bool getSupportsSafeScreening() const = 0; // pure virtual
+
+	// Lanes are models over the same data and weights with their own beta (J x lanes) and per-row state;
+	// outcomes (K x lanes) are shared with this model unless given
+	virtual bool getSupportsLanes() const = 0; // pure virtual
+
+	virtual void initializeLanes(int lanes, const double* beta, const double* outcomes,
+			bool useWeights) = 0; // pure virtual
+
+	virtual void computeGradientAndHessianLanes(int index, double* gradient, double* hessian,
+			bool useWeights) = 0; // pure virtual
+
+	virtual void updateXBetaLanes(int index, const double* delta) = 0; // pure virtual
+
+	virtual void getGradientObjectiveLanes(double* objective, bool useWeights) = 0; // pure virtual
+
+	virtual void getLogLikelihoodLanes(double* logLikelihood, bool useWeights) = 0; // pure virtual
+
+	virtual bool projectDualPoint(const std::vector<int>& unpenalized, std::vector<double>& gradient,
+			bool useWeights) = 0; // pure virtual
+
+	virtual double getDualObjective(double scale, bool useWeights) = 0; // pure virtual
+
+	virtual void computeCurvatureNorms(std::vector<double>& norms, bool useWeights) = 0; // pure virtual
+
 	virtual void computeFisherInformation(int indexOne, int indexTwo,
 			double *oinfo, bool useWeights) = 0; // pure virtual
 
+	virtual void computeFisherInformationMatrix(const std::vector<int>& indices,
+			double *oinfo, bool useWeights, int threads) = 0; // pure virtual
+
+	virtual double getApproximateLeaveOutLogLikelihood(const std::vector<int>& indices,
+			const double *inverseInformation, int threads) = 0; // pure virtual
+
+	// Curvature of the negative log-likelihood per unit of computeFisherInformationMatrix()
+	virtual double getFisherInformationScale() const = 0; // pure virtual
+
 	virtual void updateXBeta(double realDelta, int index, bool useWeights) = 0; // pure virtual
 
 	virtual void computeXBeta(double* beta, bool useWeights) = 0; // pure virtual
@@ -101,6 +150,8 @@ public:
 
 	virtual AbstractModelSpecifics* clone() const = 0; // pure virtual
 
+	virtual AbstractModelSpecifics* clone(const std::vector<double>& outcome) const = 0; // pure virtual
+
 // 	static bsccs::shared_ptr<AbstractModelSpecifics> factory(const ModelType modelType,
 //                                                            const ModelData& modelData,
 //                                                            const DeviceType deviceType);
@@ -116,6 +167,8 @@ public:
 
 	virtual void saveXBeta() = 0;
 
+	virtual void restoreXBeta() = 0;
+
 	virtual void zeroXBeta() = 0;
 
 	virtual void axpyXBeta(const double beta, const int j) = 0;
@@ -183,7 +236,6 @@ protected:
 	const std::vector<int>& hPidOriginal;
 	int* hPid;
 	size_t hPidSize;
-	std::vector<int> hPidInternal;
 
 	// RealVector hXBeta; // TODO Delegate to ModelSpecifics
 	// RealVector hXBetaSave; // Delegate
@@ -225,6 +277,8 @@ protected:
 	// CdmPtr hXt;
 	const MmBoundType boundType;
 	std::vector<double> curvature;
+
+	int threadCount;
 };
 
 typedef bsccs::shared_ptr<AbstractModelSpecifics> ModelSpecificsPtr;
@@ -0,0 +1,93 @@
+/*
+ * LruCache.h
+ *
+ *  Size-bounded least-recently-used cache with version-based invalidation
+ */
+
+#ifndef LRUCACHE_H_
+#define LRUCACHE_H_
+
+#include <list>
+#include <limits>
+
+#include "Types.h"
+
+namespace bsccs {
+
+template <typename Key, typename Value>
+class LruCache {
+public:
+	typedef bsccs::shared_ptr<Value> ValuePtr;
+
+	explicit LruCache(size_t capacity = std::numeric_limits<size_t>::max())
+		: capacity(capacity), version(0) { }
+
+	// Entries are charged by their byte cost; the most recent entry is kept even if it alone exceeds capacity
+	void setCapacity(size_t bytes) {
+		capacity = bytes;
+		evict();
+	}
+
+	// Drops every entry when the state they were computed from has changed
+	void validate(long currentVersion) {
+		if (currentVersion != version) {
+			entries.clear();
+			index.clear();
+			statistics.bytes = 0;
+			version = currentVersion;
+		}
+	}
+
+	// Returns nullptr on a miss; held values survive eviction
+	ValuePtr find(const Key& key) {
+		auto it = index.find(key);
+		if (it == index.end()) {
+			++statistics.misses;
+			return ValuePtr();
+		}
+		++statistics.hits;
+		entries.splice(entries.begin(), entries, it->second);
+		return it->second->value;
+	}
+
+	void insert(const Key& key, ValuePtr value, size_t bytes) {
+		auto it = index.find(key);
+		if (it != index.end()) {
+			statistics.bytes -= it->second->bytes;
+			entries.erase(it->second);
+		}
+		entries.push_front(Entry{key, value, bytes});
+		index[key] = entries.begin();
+		statistics.bytes += bytes;
+		evict();
+	}
+
+	const CacheStatistics& getStatistics() const { return statistics; }
+
+private:
+	struct Entry {
+		Key key;
+		ValuePtr value;
+		size_t bytes;
+	};
+
+	void evict() {
+		while (statistics.bytes > capacity && entries.size() > 1) {
+			const Entry& last = entries.back();
+			statistics.bytes -= last.bytes;
+			index.erase(last.key);
+			entries.pop_back();
+			++statistics.evictions;
+		}
+	}
+
+	size_t capacity;
+	long version;
+	std::list<Entry> entries;
+	unordered_map<Key, typename std::list<Entry>::iterator> index;
+	CacheStatistics statistics;
+};
+
+} // namespace
+
+#endif /* LRUCACHE_H_ */
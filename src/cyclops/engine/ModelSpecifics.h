@@ -14,6 +14,7 @@
 #include <stdexcept>
 #include <thread>
 #include <complex>
+#include <cstdint>
 
 // #define CYCLOPS_DEBUG_TIMING
 // #define CYCLOPS_DEBUG_TIMING_LOW
@@ -36,6 +37,8 @@
 #include "AbstractModelSpecifics.h"
 #include "Iterators.h"
 #include "ParallelLoops.h"
+#include "LruCache.h"
+#include "ThreadPool.h"
 
 #define Fraction std::complex
 
@@ -48,6 +51,18 @@ public:
 
     Storage(const RealVector& y, const RealVector& offs) : hY(y), hOffs(offs) { }
 
+    // Duality-gap screening needs a bounded per-row curvature and a closed-form conjugate
+    const static bool hasSafeScreening = false;
+
+    static RealType getCurvatureBound() {
+        return static_cast<RealType>(0);
+    }
+
+    static RealType dualObjectiveContrib(RealType y, RealType residual, RealType weight) {
+        throw new std::logic_error("Not model-specific");
+        return static_cast<RealType>(0);
+    }
+
 protected:
     const RealVector& hY;
     const RealVector& hOffs;
@@ -70,6 +85,9 @@ public:
 
 	ModelSpecifics(const ModelData<RealType>& input);
 
+	// Shares the design (and its columns) of input, but fits outcome
+	ModelSpecifics(const ModelData<RealType>& input, bsccs::shared_ptr<const RealVector> outcome);
+
 	virtual ~ModelSpecifics();
 
 	void computeGradientAndHessian(int index, double *ogradient,
@@ -80,20 +98,61 @@ public:
 			const std::vector<bool>& fixBeta,
 			bool useWeights);
 
+	virtual void computeGradient(
+			std::vector<double>& gradient,
+			const std::vector<bool>& fixBeta,
+			bool useWeights, int threads);
+
 	AbstractModelSpecifics* clone() const;
 
+	AbstractModelSpecifics* clone(const std::vector<double>& outcome) const;
+
 	virtual const std::vector<double> getXBeta();
 
 	virtual const std::vector<double> getXBetaSave();
 
 	virtual void saveXBeta();
 
+	virtual void restoreXBeta();
+
+	virtual void makeDirty();
+
 	virtual void zeroXBeta();
 
 	virtual void axpyXBeta(const double beta, const int j);
 
 	virtual void computeXBeta(double* beta, bool useWeights);
 
+	virtual void setGramThreshold(int threshold);
+
+	virtual void setCrossTermCacheSize(size_t bytes);
+
+	virtual CacheStatistics getCrossTermCacheStatistics() const;
+
+	virtual void setWeightPatternCount(int count);
+
+	virtual bool setQuadraticApproximation(bool approximate, bool useWeights);
+
+	virtual bool getSupportsSafeScreening() const;
+
+	virtual bool getSupportsLanes() const;
+
+	virtual void initializeLanes(int lanes, const double* beta, const double* outcomes, bool useWeights);
+
+	virtual void computeGradientAndHessianLanes(int index, double* gradient, double* hessian, bool useWeights);
+
+	virtual void updateXBetaLanes(int index, const double* delta);
+
+	virtual void getGradientObjectiveLanes(double* objective, bool useWeights);
+
+	virtual void getLogLikelihoodLanes(double* logLikelihood, bool useWeights);
+
+	virtual bool projectDualPoint(const std::vector<int>& unpenalized, std::vector<double>& gradient, bool useWeights);
+
+	virtual double getDualObjective(double scale, bool useWeights);
+
+	virtual void computeCurvatureNorms(std::vector<double>& norms, bool useWeights);
+
 	//virtual double getGradientObjective();
 
 	virtual void deviceInitialization();
@@ -119,10 +178,14 @@ protected:
 
     const ModelData<RealType>& modelData;
     const CompressedDataMatrix<RealType>& hX;
+    bsccs::shared_ptr<const RealVector> outcome; // Set when not fitting the outcome of modelData
 
     typedef bsccs::shared_ptr<CompressedDataMatrix<RealType>> CdmPtr;
     CdmPtr hXt;
 
+    RealVector hResidual; // Per-row gradient contributions, for X^T r
+    RealVector hDualResidual; // Unscaled dual point for safe screening, orthogonal to unpenalized columns
+
     // Moved from AMS
     RealVector accDenomPid;
     RealVector accNumerPid;
@@ -153,8 +216,61 @@ protected:
     RealType logLikelihoodFixedTerm;
 
     typedef bsccs::shared_ptr<CompressedDataColumn<RealType>> CDCPtr;
-    typedef std::map<int, CDCPtr> HessianSparseMap;
-    HessianSparseMap hessianSparseCrossTerms;
+    LruCache<int, CompressedDataColumn<RealType>> hessianSparseCrossTerms; // Per-stratum cross terms, valid for one xBetaVersion
+    long xBetaVersion; // Bumped whenever hXBeta or offsExpXBeta change
+
+    // Covariance-update mode for models with constant curvature (precomputeHessian)
+    int gramThreshold; // Largest J for which the mode is used, 0 disables, -1 chooses from J and nnz(X)
+    bool gramEnabled;
+    size_t gramEntries; // nnz(X); the automatic mode starts once column scans have cost as much as
+    size_t gramScanned; // the Gram columns of the moved covariates, gramMovedCount * gramEntries
+    std::vector<bool> gramMoved;
+    size_t gramMovedCount;
+    bool gramUseWeights;
+    std::vector<RealVector> gramColumns; // X^T W x_j, filled once x_j enters the active set
+    RealVector gramXjY; // x_j^T W y, filled with gramColumns
+    RealVector gramGradient;
+    std::vector<bool> gramGradientKnown;
+    RealType gramObjective; // getGradientObjective(), shifted with each pending step
+    bool gramObjectiveKnown;
+    RealVector gramPendingDelta; // Steps not yet applied to hXBeta
+    std::vector<int> gramPendingIndices;
+
+    // Quadratic (IRLS) approximation of the likelihood about hXBetaAnchor, for models with independent rows
+    bool quadraticApproximation;
+    RealVector hWorkingWeight; // Per-row curvature contributions at the anchor
+    RealVector hXBetaAnchor;
+
+    // Lanes (models with independent rows only); per-row state is stored row-major with the lane index fastest
+    int laneCount;
+    RealVector laneY;
+    RealVector laneXjY; // J x lanes
+    RealVector laneXBeta;
+    RealVector laneOffsExpXBeta;
+    RealVector laneDenominator;
+    RealVector laneGradient;
+    RealVector laneHessian;
+
+    // Exact conditional logistic regression; strata are handed to the pool largest first
+    std::vector<int> strataBySize;
+    bsccs::unique_ptr<ThreadPool> strataPool;
+    int strataPoolThreads;
+    RealVector stratumGradient;
+    RealVector stratumHessian;
+
+    ThreadPool& getStrataPool(int threads);
+
+    // Risk-set numbering and sparse indices for one pattern of zero weights, so fold switches can reuse them
+    struct AccumulationLayout {
+        std::vector<bool> excluded; // Empty when no weights were given
+        std::vector<int> pid;
+        std::vector<int> accReset;
+        size_t N;
+        std::vector<IndexVectorPtr> sparseIndices;
+    };
+    LruCache<uint64_t, AccumulationLayout> accumulationLayouts; // Keyed by a hash of the zero-weight pattern
+    size_t accumulationLayoutBytes; // Of the layout without weights; sizes accumulationLayouts
+    bsccs::shared_ptr<AccumulationLayout> accumulationLayout; // In use; hPid points into it
 
     // End of AMS move
 
@@ -165,6 +281,12 @@ protected:
 
 	void computeFisherInformation(int indexOne, int indexTwo, double *oinfo, bool useWeights);
 
+	void computeFisherInformationMatrix(const std::vector<int>& indices, double *oinfo, bool useWeights, int threads);
+
+	double getApproximateLeaveOutLogLikelihood(const std::vector<int>& indices, const double *inverseInformation, int threads);
+
+	double getFisherInformationScale() const;
+
 	void updateXBeta(double delta, int index, bool useWeights);
 
 	void computeRemainingStatistics(bool useWeights);
@@ -238,6 +360,26 @@ private:
 			int index, double *ogradient,
             double *ohessian, Weights w);
 
+	template <class Weights>
+	void computeResidualImpl();
+
+	template <class IteratorType>
+	void computeQuadraticGradientAndHessianImpl(int index, double *ogradient, double *ohessian);
+
+	template <class IteratorType, class Weights>
+	void computeGradientAndHessianLanesImpl(int index, double *gradient, double *hessian, Weights w);
+
+	template <class IteratorType>
+	void updateXBetaLanesImpl(const double* delta, int index);
+
+	void computeLaneStatistics(int k);
+
+	template <class IteratorType>
+	double computeCurvatureNormImpl(int index, bool useWeights);
+
+	template <class IteratorType>
+	void computeTransposeProductImpl(std::vector<double>& gradient, int threads);
+
 	template <class IteratorType, class Weights>
 	void incrementNumeratorForGradientImpl(int index);
 
@@ -255,13 +397,34 @@ private:
 	template <class IteratorTypeOne, class IteratorTypeTwo, class Weights>
 	void computeFisherInformationImpl(int indexOne, int indexTwo, double *oinfo, Weights w);
 
+	template <class IteratorType>
+	void computeFisherInformationMatrixImpl(const std::vector<int>& indices, double *oinfo, int threads);
+
+	template <class IteratorType>
+	void computeLeaveOutXBetaImpl(const std::vector<int>& indices, const double *inverseInformation,
+			int threads, RealVector& leaveOutXBeta);
+
 	template<class IteratorType>
-	SparseIterator<RealType> getSubjectSpecificHessianIterator(int index);
+	CDCPtr getSubjectSpecificHessianTerms(int index);
+
+	CDCPtr getSubjectSpecificHessianTerms(int index);
 
 	void computeXjY(bool useCrossValidation);
 
 	void computeXjX(bool useCrossValidation);
 
+	bool useGramUpdates(bool useWeights);
+
+	void invalidateGramUpdates(bool clearColumns);
+
+	// Applies (or drops) steps taken in the covariance-update mode to hXBeta
+	void refreshXBeta(bool apply = true);
+
+	void computeGramColumn(int index, bool useWeights);
+
+	template <class IteratorType>
+	void computeGramColumnImpl(int index, bool useWeights);
+
 	void computeNtoKIndices(bool useCrossValidation);
 
 	void initializeMmXt();
@@ -412,6 +575,10 @@ struct GLMProjection {
 public:
 	const static bool precomputeGradient = true; // XjY
 
+	static double getFisherInformationScale() {
+		return 1.0;
+	}
+
 	const static bool likelihoodHasDenominator = true;
 
 	const static bool hasTwoNumeratorTerms = true;
@@ -967,6 +1134,28 @@ public:
 		return t / (t + static_cast<RealType>(1));
 	}
 
+	const static bool hasSafeScreening = true;
+
+	static RealType getCurvatureBound() {
+	    return static_cast<RealType>(0.25); // p (1 - p)
+	}
+
+	static RealType dualObjectiveContrib(RealType y, RealType residual, RealType weight) {
+	    // Binary entropy of t = y - residual / weight, the conjugate of the weighted logistic loss
+	    const RealType t = y - residual / weight;
+	    if (t < static_cast<RealType>(0) || t > static_cast<RealType>(1)) {
+	        return -std::numeric_limits<RealType>::infinity(); // Outside the dual domain
+	    }
+	    RealType entropy = static_cast<RealType>(0);
+	    if (t > static_cast<RealType>(0)) {
+	        entropy -= t * std::log(t);
+	    }
+	    if (t < static_cast<RealType>(1)) {
+	        entropy -= (static_cast<RealType>(1) - t) * std::log(static_cast<RealType>(1) - t);
+	    }
+	    return weight * entropy;
+	}
+
 	using Storage<RealType>::offsExpXBeta;
 	using Storage<RealType>::denomPid;
 	using Storage<RealType>::hKWeight;
@@ -1233,6 +1422,21 @@ public:
 		return - (residual * residual);
 	}
 
+	const static bool hasSafeScreening = true;
+
+	static RealType getCurvatureBound() {
+	    return static_cast<RealType>(2);
+	}
+
+	static double getFisherInformationScale() {
+	    return 2.0; // Information is X^T X, half the curvature of (y - xBeta)^2
+	}
+
+	static RealType dualObjectiveContrib(RealType y, RealType residual, RealType weight) {
+	    // Conjugate of weight * (y - z)^2
+	    return residual * y - residual * residual / (static_cast<RealType>(4) * weight);
+	}
+
 	template <class XType>
 	static RealType gradientNumeratorContrib(XType x, RealType predictor, RealType xBeta, RealType y) {
 			return static_cast<RealType>(2) * (xBeta - y) * x;
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <numeric>
 #include <limits>
+#include <atomic>
 
 #include "ModelSpecifics.h"
 #include "Iterators.h"
@@ -21,11 +22,6 @@
 #include "ParallelLoops.h"
 #include "Ranges.h"
 
-#ifdef USE_RCPP_PARALLEL
-#include <tbb/combinable.h>
-#include <tbb/parallel_for.h>
-#endif
-
 //#include "R.h"
 #include "Rcpp.h" // TODO Remove
 
@@ -49,21 +45,8 @@
 //#define NEW_WAY1
 #define NEW_WAY2
 
-//#define USE_BIGNUM
-#define USE_LONG_DOUBLE
-
 namespace bsccs {
 
-#ifdef USE_BIGNUM
-	typedef bigNum DDouble;
-#else
-	#ifdef USE_LONG_DOUBLE
-		typedef long double DDouble;
-	#else
-		typedef double DDouble;
-	#endif
-#endif
-
 #if defined(DEBUG_COX) || defined(DEBUG_COX_MIN)
     using std::cerr;
     using std::endl;
@@ -75,7 +58,19 @@ template <class BaseModel,typename RealType>
 ModelSpecifics<BaseModel,RealType>::ModelSpecifics(const ModelData<RealType>& input)
 	: AbstractModelSpecifics(input), BaseModel(input.getYVectorRef(), input.getTimeVectorRef()),
    modelData(input),
-   hX(modelData.getX())
+   hX(modelData.getX()),
+   xBetaVersion(0),
+   gramThreshold(0),
+   gramEnabled(false),
+   gramEntries(0),
+   gramScanned(0),
+   gramMovedCount(0),
+   gramUseWeights(false),
+   gramObjectiveKnown(false),
+   quadraticApproximation(false),
+   laneCount(0),
+   strataPoolThreads(0),
+   accumulationLayoutBytes(0)
    // hY(input.getYVectorRef()),
    // hOffs(input.getTimeVectorRef())
  //  hPidOriginal(input.getPidVectorRef()), hPid(const_cast<int*>(hPidOriginal.data())),
@@ -95,14 +90,51 @@ ModelSpecifics<BaseModel,RealType>::ModelSpecifics(const ModelData<RealType>& in
 
 }
 
+template <class BaseModel,typename RealType>
+ModelSpecifics<BaseModel,RealType>::ModelSpecifics(const ModelData<RealType>& input,
+		bsccs::shared_ptr<const RealVector> outcome)
+	: AbstractModelSpecifics(input), BaseModel(*outcome, input.getTimeVectorRef()),
+   modelData(input),
+   hX(modelData.getX()),
+   outcome(outcome),
+   xBetaVersion(0),
+   gramThreshold(0),
+   gramEnabled(false),
+   gramEntries(0),
+   gramScanned(0),
+   gramMovedCount(0),
+   gramUseWeights(false),
+   gramObjectiveKnown(false),
+   quadraticApproximation(false),
+   laneCount(0),
+   strataPoolThreads(0),
+   accumulationLayoutBytes(0) {
+	// Do nothing
+}
+
 template <class BaseModel, typename RealType>
 AbstractModelSpecifics* ModelSpecifics<BaseModel,RealType>::clone() const {
+	if (outcome) {
+		return new ModelSpecifics<BaseModel,RealType>(modelData, outcome);
+	}
 	return new ModelSpecifics<BaseModel,RealType>(modelData);
 }
 
+template <class BaseModel, typename RealType>
+AbstractModelSpecifics* ModelSpecifics<BaseModel,RealType>::clone(const std::vector<double>& y) const {
+	return new ModelSpecifics<BaseModel,RealType>(modelData,
+		bsccs::make_shared<const RealVector>(y.begin(), y.end()));
+}
+
 template <class BaseModel, typename RealType>
 double ModelSpecifics<BaseModel,RealType>::getGradientObjective(bool useCrossValidation) {
 
+		const bool gram = useGramUpdates(useCrossValidation);
+		if (gram && gramObjectiveKnown) { // Kept current by updateXBeta()
+			return static_cast<double>(gramObjective);
+		}
+		refreshXBeta();
+
 		auto& xBeta = getXBeta();
 
 		RealType criterion = 0;
@@ -116,6 +148,11 @@ double ModelSpecifics<BaseModel,RealType>::getGradientObjective(bool useCrossVal
 			}
 		}
 
+		if (gram) {
+			gramObjective = criterion;
+			gramObjectiveKnown = true;
+		}
+
 		return static_cast<double> (criterion);
 	}
 
@@ -285,6 +322,7 @@ void ModelSpecifics<BaseModel,RealType>::initializeMM(
 
 template <class BaseModel,typename RealType>
 const std::vector<double> ModelSpecifics<BaseModel,RealType>::getXBeta() {
+    refreshXBeta();
     return std::vector<double>(std::begin(hXBeta), std::end(hXBeta));
 }
 
@@ -295,11 +333,16 @@ const std::vector<double> ModelSpecifics<BaseModel,RealType>::getXBetaSave() {
 
 template <class BaseModel,typename RealType>
 void ModelSpecifics<BaseModel,RealType>::zeroXBeta() {
+	refreshXBeta(false);
 	std::fill(std::begin(hXBeta), std::end(hXBeta), 0.0);
+	++xBetaVersion;
+	invalidateGramUpdates(false);
 }
 
 template <class BaseModel,typename RealType>
 void ModelSpecifics<BaseModel,RealType>::saveXBeta() {
+	refreshXBeta();
+
 	auto& xBeta = getXBeta();
 	if (hXBetaSave.size() < xBeta.size()) {
 		hXBetaSave.resize(xBeta.size());
@@ -307,6 +350,20 @@ void ModelSpecifics<BaseModel,RealType>::saveXBeta() {
 	std::copy(std::begin(xBeta), std::end(xBeta), std::begin(hXBetaSave));
 }
 
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::makeDirty() {
+	AbstractModelSpecifics::makeDirty();
+	invalidateGramUpdates(false);
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::restoreXBeta() {
+	refreshXBeta(false);
+	std::copy(std::begin(hXBetaSave), std::begin(hXBetaSave) + hXBeta.size(), std::begin(hXBeta));
+	++xBetaVersion;
+	invalidateGramUpdates(false);
+}
+
 
 
 template <class BaseModel,typename RealType>
@@ -316,6 +373,10 @@ void ModelSpecifics<BaseModel,RealType>::computeXBeta(double* beta, bool useWeig
         initializeMmXt();
     }
 
+    refreshXBeta(false);
+    ++xBetaVersion;
+    invalidateGramUpdates(false);
+
 #ifdef CYCLOPS_DEBUG_TIMING
     auto start = bsccs::chrono::steady_clock::now();
 #endif
@@ -392,6 +453,10 @@ void ModelSpecifics<BaseModel,RealType>::axpy(RealType* y, const RealType alpha,
 
 template <class BaseModel,typename RealType>
 void ModelSpecifics<BaseModel,RealType>::axpyXBeta(const double beta, const int j) {
+	refreshXBeta();
+
+	++xBetaVersion;
+	invalidateGramUpdates(false);
 
 #ifdef CYCLOPS_DEBUG_TIMING
     auto start = bsccs::chrono::steady_clock::now();
@@ -424,6 +489,9 @@ void ModelSpecifics<BaseModel,RealType>::axpyXBeta(const double beta, const int
 
 template <class BaseModel,typename RealType>
 void ModelSpecifics<BaseModel,RealType>::setWeights(double* inWeights, bool useCrossValidation) {
+
+	invalidateGramUpdates(true);
+
 	// Set K weights
 	if (hKWeight.size() != K) {
 		hKWeight.resize(K);
@@ -519,6 +587,171 @@ void ModelSpecifics<BaseModel, RealType>::computeXjX(bool useCrossValidation) {
 	}
 }
 
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::setGramThreshold(int threshold) {
+	if (threshold != gramThreshold) {
+		refreshXBeta();
+		gramThreshold = threshold;
+		gramGradientKnown.clear();
+		gramScanned = 0;
+		gramMoved.assign(J, false);
+		gramMovedCount = 0;
+		if (threshold < 0) {
+			// Automatic: a step shifts J cached gradients instead of scanning x_j twice, and the
+			// Gram columns of the active set stay no larger than X, while J * J <= nnz(X)
+			gramEntries = 0;
+			for (size_t j = 0; j < J; ++j) {
+				gramEntries += hX.getNumberOfNonZeroEntries(j);
+			}
+			gramEnabled = BaseModel::precomputeHessian && J * J <= gramEntries;
+		} else {
+			gramEnabled = J <= static_cast<size_t>(threshold);
+		}
+	}
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::setCrossTermCacheSize(size_t bytes) {
+	hessianSparseCrossTerms.setCapacity(bytes);
+}
+
+template <class BaseModel,typename RealType>
+CacheStatistics ModelSpecifics<BaseModel,RealType>::getCrossTermCacheStatistics() const {
+	return hessianSparseCrossTerms.getStatistics();
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::setWeightPatternCount(int count) {
+	if (initializeAccumulationVectors()) {
+		accumulationLayouts.setCapacity(static_cast<size_t>(std::max(count, 1)) * accumulationLayoutBytes);
+	}
+}
+
+template <class BaseModel,typename RealType>
+bool ModelSpecifics<BaseModel,RealType>::setQuadraticApproximation(bool approximate, bool useWeights) {
+	refreshXBeta();
+
+	if (!BaseModel::hasIndependentRows || BaseModel::precomputeHessian) { // Compile-time switch
+		return false; // Exact quadratic models need no approximation
+	}
+	if (approximate && !quadraticApproximation) {
+		// Working residuals and weights are fixed at the current xBeta until the approximation is released
+		if (useWeights) {
+			computeResidualImpl<WeightedOperation>();
+		} else {
+			computeResidualImpl<UnweightedOperation>();
+		}
+		hXBetaAnchor = hXBeta;
+	}
+	quadraticApproximation = approximate;
+	return true;
+}
+
+template <class BaseModel,typename RealType>
+bool ModelSpecifics<BaseModel,RealType>::useGramUpdates(bool useWeights) {
+	if (!BaseModel::precomputeHessian || !gramEnabled) {
+		return false;
+	}
+	if (gramThreshold < 0 && (gramMovedCount == 0 || gramScanned < gramMovedCount * gramEntries)) {
+		return false; // Still cheaper to scan
+	}
+	if (gramGradientKnown.size() != J || gramUseWeights != useWeights) {
+		refreshXBeta();
+		gramGradient.assign(J, static_cast<RealType>(0));
+		gramGradientKnown.assign(J, false);
+		gramColumns.assign(J, RealVector());
+		gramXjY.assign(J, static_cast<RealType>(0));
+		gramPendingDelta.assign(J, static_cast<RealType>(0));
+		gramObjectiveKnown = false;
+		gramUseWeights = useWeights;
+	}
+	return true;
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::invalidateGramUpdates(bool clearColumns) {
+	std::fill(gramGradientKnown.begin(), gramGradientKnown.end(), false);
+	gramObjectiveKnown = false;
+	if (clearColumns) {
+		for (auto& column : gramColumns) {
+			RealVector().swap(column);
+		}
+		gramScanned = 0;
+		gramMoved.assign(J, false);
+		gramMovedCount = 0;
+	}
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::refreshXBeta(bool apply) {
+	for (int index : gramPendingIndices) {
+		const RealType delta = gramPendingDelta[index];
+		gramPendingDelta[index] = static_cast<RealType>(0);
+		if (apply && delta != static_cast<RealType>(0)) {
+			for (GenericIterator<RealType> it(hX, index); it; ++it) {
+				hXBeta[it.index()] += delta * it.value();
+			}
+		}
+	}
+	gramPendingIndices.clear();
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::computeGramColumn(int index, bool useWeights) {
+
+	if (!hXt) {
+		initializeMmXt();
+	}
+
+	RealType xjy = static_cast<RealType>(0); // Shifts getGradientObjective() with each step
+	for (GenericIterator<RealType> it(hX, index); it; ++it) {
+		const int k = it.index();
+		xjy += useWeights ? it.value() * hY[k] * hKWeight[k] : it.value() * hY[k];
+	}
+	gramXjY[index] = xjy;
+
+	switch (hXt->getFormatType(0)) {
+	case INDICATOR :
+		computeGramColumnImpl<IndicatorIterator<RealType>>(index, useWeights);
+		break;
+	case SPARSE :
+		computeGramColumnImpl<SparseIterator<RealType>>(index, useWeights);
+		break;
+	default : { // Dense rows would cost O(nnz(x_index) * J); scatter W x_index and sweep X once instead
+		RealVector scattered(K, static_cast<RealType>(0));
+		for (GenericIterator<RealType> it(hX, index); it; ++it) {
+			const int k = it.index();
+			scattered[k] = useWeights ? hKWeight[k] * it.value() : it.value();
+		}
+		auto& column = gramColumns[index];
+		column.resize(J);
+		for (size_t j = 0; j < J; ++j) {
+			RealType sum = static_cast<RealType>(0);
+			for (GenericIterator<RealType> it(hX, j); it; ++it) {
+				sum += it.value() * scattered[it.index()];
+			}
+			column[j] = sum;
+		}
+		break;
+	}
+	}
+}
+
+template <class BaseModel,typename RealType> template <class IteratorType>
+void ModelSpecifics<BaseModel,RealType>::computeGramColumnImpl(int index, bool useWeights) {
+
+	// Accumulate the sparse rows touched by x_index; costs O(nnz(x_index) * row length)
+	auto& column = gramColumns[index];
+	column.assign(J, static_cast<RealType>(0));
+	for (GenericIterator<RealType> it(hX, index); it; ++it) {
+		const int k = it.index();
+		const RealType scale = useWeights ? hKWeight[k] * it.value() : it.value();
+		for (IteratorType row(*hXt, k); row; ++row) {
+			column[row.index()] += row.value() * scale;
+		}
+	}
+}
+
 template<class BaseModel, typename RealType>
 void ModelSpecifics<BaseModel, RealType>::computeNtoKIndices(bool useCrossValidation) {
 
@@ -572,6 +805,7 @@ void ModelSpecifics<BaseModel,RealType>::computeFixedTermsInGradientAndHessian(b
 
 template <class BaseModel,typename RealType>
 double ModelSpecifics<BaseModel,RealType>::getLogLikelihood(bool useCrossValidation) {
+	refreshXBeta();
 
 #ifdef CYCLOPS_DEBUG_TIMING
 	auto start = bsccs::chrono::steady_clock::now();
@@ -618,6 +852,7 @@ double ModelSpecifics<BaseModel,RealType>::getLogLikelihood(bool useCrossValidat
 
 template <class BaseModel,typename RealType>
 double ModelSpecifics<BaseModel,RealType>::getPredictiveLogLikelihood(double* weights) {
+	refreshXBeta();
 
     std::vector<double> saveKWeight;
 	if (BaseModel::cumulativeGradientAndHessian)	{
@@ -630,8 +865,7 @@ double ModelSpecifics<BaseModel,RealType>::getPredictiveLogLikelihood(double* we
 	        saveKWeight[k] = hKWeight[k]; // make copy to a double vector
 	    }
 
-		setPidForAccumulation(weights);
-		setWeights(weights, true); // set new weights
+		setWeights(weights, true); // set new weights, also swaps in their risk sets
 		computeRemainingStatistics(true); // compute accDenomPid
 	}
 
@@ -648,7 +882,6 @@ double ModelSpecifics<BaseModel,RealType>::getPredictiveLogLikelihood(double* we
 	}
 
 	if (BaseModel::cumulativeGradientAndHessian) {
-		setPidForAccumulation(&saveKWeight[0]);
 	    setWeights(saveKWeight.data(), true); // set old weights
 		computeRemainingStatistics(true);
 	}
@@ -658,6 +891,7 @@ double ModelSpecifics<BaseModel,RealType>::getPredictiveLogLikelihood(double* we
 
 template <class BaseModel,typename RealType>
 void ModelSpecifics<BaseModel,RealType>::getPredictiveEstimates(double* y, double* weights){
+	refreshXBeta();
 
 	if (weights) {
 		for (size_t k = 0; k < K; ++k) {
@@ -689,6 +923,35 @@ void ModelSpecifics<BaseModel,RealType>::computeGradientAndHessian(int index, do
 	    return;
 	}
 
+	if (quadraticApproximation) {
+		switch (hX.getFormatType(index)) {
+			case INDICATOR :
+				computeQuadraticGradientAndHessianImpl<IndicatorIterator<RealType>>(index, ogradient, ohessian);
+				break;
+			case SPARSE :
+				computeQuadraticGradientAndHessianImpl<SparseIterator<RealType>>(index, ogradient, ohessian);
+				break;
+			case DENSE :
+				computeQuadraticGradientAndHessianImpl<DenseIterator<RealType>>(index, ogradient, ohessian);
+				break;
+			case INTERCEPT :
+				computeQuadraticGradientAndHessianImpl<InterceptIterator<RealType>>(index, ogradient, ohessian);
+				break;
+		}
+		return;
+	}
+
+	const bool gram = useGramUpdates(useWeights);
+	if (gram && gramGradientKnown[index]) { // Kept current by updateXBeta()
+		*ogradient = static_cast<double>(gramGradient[index]);
+		*ohessian = static_cast<double>(static_cast<RealType>(2.0) * hXjX[index]);
+		return;
+	}
+	refreshXBeta();
+	if (gramEnabled) {
+		gramScanned += hX.getNumberOfNonZeroEntries(index);
+	}
+
 	// Run-time dispatch, so virtual call should not effect speed
 	if (useWeights) {
 		switch (hX.getFormatType(index)) {
@@ -722,6 +985,11 @@ void ModelSpecifics<BaseModel,RealType>::computeGradientAndHessian(int index, do
 		}
 	}
 
+	if (gram) {
+		gramGradient[index] = static_cast<RealType>(*ogradient);
+		gramGradientKnown[index] = true;
+	}
+
 #ifdef CYCLOPS_DEBUG_TIMING
 #ifndef CYCLOPS_DEBUG_TIMING_LOW
 	auto end = bsccs::chrono::steady_clock::now();
@@ -745,6 +1013,7 @@ void ModelSpecifics<BaseModel,RealType>::computeMMGradientAndHessian(
         std::vector<GradientHessian>& gh,
         const std::vector<bool>& fixBeta,
         bool useWeights) {
+	refreshXBeta();
 
     if (norm.size() == 0) {
         initializeMM(boundType, fixBeta);
@@ -855,180 +1124,741 @@ void ModelSpecifics<BaseModel,RealType>::computeMMGradientAndHessianImpl(int ind
 #endif
 }
 
-template <class BaseModel,typename RealType> template <class IteratorType, class Weights>
-void ModelSpecifics<BaseModel,RealType>::computeGradientAndHessianImpl(int index, double *ogradient,
-		double *ohessian, Weights w) {
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::computeGradient(
+        std::vector<double>& gradient,
+        const std::vector<bool>& fixBeta,
+        bool useWeights, int threads) {
+	refreshXBeta();
 
 #ifdef CYCLOPS_DEBUG_TIMING
-#ifdef CYCLOPS_DEBUG_TIMING_LOW
-	auto start = bsccs::chrono::steady_clock::now();
-#endif
+    auto start = bsccs::chrono::steady_clock::now();
 #endif
 
-	RealType gradient = static_cast<RealType>(0);
-	RealType hessian = static_cast<RealType>(0);
+    if (gradient.size() < J) {
+        gradient.resize(J);
+    }
 
-    if (BaseModel::cumulativeGradientAndHessian) { // Compile-time switch
+    if (BaseModel::hasIndependentRows) { // Compile-time switch
 
-    	if (sparseIndices[index] == nullptr || sparseIndices[index]->size() > 0) {
+        // Gradient is linear in x, so g = X^T r with r_k the contribution of row k at x = 1
+        if (useWeights) {
+            computeResidualImpl<WeightedOperation>();
+        } else {
+            computeResidualImpl<UnweightedOperation>();
+        }
 
-    	    IteratorType it(sparseIndices[index].get(), N);
+        if (!hXt) {
+            initializeMmXt();
+        }
 
-    	    RealType accNumerPid  = static_cast<RealType>(0);
-    	    RealType accNumerPid2 = static_cast<RealType>(0);
+        switch (hXt->getFormatType(0)) {
+        case INDICATOR :
+            computeTransposeProductImpl<IndicatorIterator<RealType>>(gradient, threads);
+            break;
+        case SPARSE :
+            computeTransposeProductImpl<SparseIterator<RealType>>(gradient, threads);
+            break;
+        case DENSE :
+            computeTransposeProductImpl<DenseIterator<RealType>>(gradient, threads);
+            break;
+        case INTERCEPT :
+            std::fill(gradient.begin(), gradient.end(), 0.0);
+            break;
+        }
 
-    	    // find start relavent accumulator reset point
-    	    auto reset = begin(accReset);
-    	    while( *reset < it.index() ) {
-    	        ++reset;
-    	    }
+        for (int j = 0; j < J; ++j) {
+            if (fixBeta[j]) {
+                gradient[j] = 0.0;
+            } else if (BaseModel::precomputeGradient) { // Compile-time switch
+                gradient[j] -= hXjY[j];
+            }
+        }
 
-    	    for (; it; ) {
-    	        int i = it.index();
+    } else {
 
-    	        if (*reset <= i) {
-    	            accNumerPid  = static_cast<RealType>(0.0);
-    	            accNumerPid2 = static_cast<RealType>(0.0);
-    	            ++reset;
-    	        }
+        // Dependent rows; fall back to column-wise reductions
+        for (int j = 0; j < J; ++j) {
+            if (fixBeta[j]) {
+                gradient[j] = 0.0;
+            } else {
+                double hessian;
+                computeNumeratorForGradient(j, useWeights);
+                computeGradientAndHessian(j, &gradient[j], &hessian, useWeights);
+            }
+        }
+    }
 
-    	        const auto numerator1 = numerPid[i];
-    	        const auto numerator2 = numerPid2[i];
+#ifdef CYCLOPS_DEBUG_TIMING
+    auto end = bsccs::chrono::steady_clock::now();
+    ///////////////////////////"
+    duration["computeGradient  "] += bsccs::chrono::duration_cast<chrono::TimingUnits>(end - start).count();
+#endif
+}
 
-    	        accNumerPid += numerator1;
-    	        accNumerPid2 += numerator2;
+template <class BaseModel,typename RealType> template <class Weights>
+void ModelSpecifics<BaseModel,RealType>::computeResidualImpl() {
 
-    	        // Compile-time delegation
-    	        BaseModel::incrementGradientAndHessian(it,
-                        w, // Signature-only, for iterator-type specialization
-                        &gradient, &hessian, accNumerPid, accNumerPid2,
-                        accDenomPid[i], hNWeight[i], 0.0, hXBeta[i], hY[i]); // When function is in-lined, compiler will only use necessary arguments
+    if (hResidual.size() != K) {
+        hResidual.resize(K);
+    }
 
-    	        ++it;
+    if (hWorkingWeight.size() != K) {
+        hWorkingWeight.resize(K);
+    }
 
-    	        if (IteratorType::isSparse) {
+    for (int k = 0; k < K; ++k) {
+        const RealType numerator = BaseModel::gradientNumeratorContrib(
+            static_cast<RealType>(1), offsExpXBeta[k], hXBeta[k], hY[k]);
+        const Fraction<RealType> contribution =
+            BaseModel::template incrementGradientAndHessian<IndicatorIterator<RealType>, Weights>(
+                Fraction<RealType>(0, 0), numerator, numerator, denomPid[k], hNWeight[k],
+                hXBeta[k], hY[k]);
+        hResidual[k] = contribution.real();
+        hWorkingWeight[k] = contribution.imag();
+    }
+}
 
-    	            const int next = it ? it.index() : N;
-    	            for (++i; i < next; ++i) {
+template <class BaseModel,typename RealType>
+bool ModelSpecifics<BaseModel,RealType>::getSupportsSafeScreening() const {
+    return BaseModel::hasSafeScreening;
+}
 
-    	                if (*reset <= i) {
-    	                    accNumerPid  = static_cast<RealType>(0.0);
-    	                    accNumerPid2 = static_cast<RealType>(0.0);
-    	                    ++reset;
-    	                }
+template <class BaseModel,typename RealType>
+double ModelSpecifics<BaseModel,RealType>::getFisherInformationScale() const {
+    return BaseModel::getFisherInformationScale();
+}
 
-    	                BaseModel::incrementGradientAndHessian(it,
-                                w, // Signature-only, for iterator-type specialization
-    	                        &gradient, &hessian, accNumerPid, accNumerPid2,
-    	                        accDenomPid[i], hNWeight[i], static_cast<RealType>(0), hXBeta[i], hY[i]); // When function is in-lined, compiler will only use necessary arguments
-    	            }
-    	        }
-    	    }
-		}
+template <class BaseModel,typename RealType>
+bool ModelSpecifics<BaseModel,RealType>::getSupportsLanes() const {
+    return BaseModel::hasIndependentRows;
+}
 
-	} else if (BaseModel::hasIndependentRows) {
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::initializeLanes(int lanes, const double* beta,
+        const double* outcomes, bool useWeights) {
+
+    laneCount = lanes;
+    laneY.resize(K * lanes);
+    for (size_t k = 0; k < K; ++k) {
+        for (int l = 0; l < lanes; ++l) {
+            laneY[k * lanes + l] = outcomes ? static_cast<RealType>(outcomes[k * lanes + l]) : hY[k];
+        }
+    }
 
-	    IteratorType it(hX, index);
+    if (BaseModel::precomputeGradient) { // Compile-time switch; as computeXjY() for independent rows
+        laneXjY.assign(J * lanes, static_cast<RealType>(0));
+        for (size_t j = 0; j < J; ++j) {
+            RealType* xjy = &laneXjY[j * lanes];
+            for (GenericIterator<RealType> it(hX, j); it; ++it) {
+                const int k = it.index();
+                const RealType* y = &laneY[k * lanes];
+                for (int l = 0; l < lanes; ++l) {
+                    xjy[l] += useWeights ? it.value() * y[l] * hKWeight[k] : it.value() * y[l];
+                }
+            }
+        }
+    }
 
-	    for (; it; ++it) {
-	        const int i = it.index();
+    laneXBeta.assign(K * lanes, static_cast<RealType>(0));
+    laneOffsExpXBeta.resize(K * lanes);
+    laneDenominator.resize(K * lanes);
+    laneGradient.resize(lanes);
+    laneHessian.resize(lanes);
 
-	        RealType numerator1 = BaseModel::gradientNumeratorContrib(it.value(), offsExpXBeta[i], hXBeta[i], hY[i]);
-	        RealType numerator2 = (!IteratorType::isIndicator && BaseModel::hasTwoNumeratorTerms) ?
-	                BaseModel::gradientNumerator2Contrib(it.value(), offsExpXBeta[i]) : static_cast<RealType>(0);
+    for (size_t j = 0; j < J; ++j) {
+        const double* b = beta + j * lanes;
+        for (GenericIterator<RealType> it(hX, j); it; ++it) {
+            RealType* xBeta = &laneXBeta[it.index() * lanes];
+            const RealType x = it.value();
+            for (int l = 0; l < lanes; ++l) {
+                xBeta[l] += x * static_cast<RealType>(b[l]);
+            }
+        }
+    }
 
-	        // Compile-time delegation
-	        BaseModel::incrementGradientAndHessian(it,
-                    w, // Signature-only, for iterator-type specialization
-                    &gradient, &hessian, numerator1, numerator2,
-                    denomPid[i], hNWeight[i], it.value(), hXBeta[i], hY[i]); // When function is in-lined, compiler will only use necessary arguments
-	    }
+    for (size_t k = 0; k < K; ++k) {
+        computeLaneStatistics(k);
+    }
+}
 
-	} else if (BaseModel::exactCLR) {
-	    //tbb::mutex mutex0;
-
-#ifdef USE_RCPP_PARALLEL
-
-	    tbb::combinable<RealType> newGrad(static_cast<RealType>(0));
-	    tbb::combinable<RealType> newHess(static_cast<RealType>(0));
-
-	    auto func = [&,index](const tbb::blocked_range<int>& range){
-
-	        using std::isinf;
-
-	        for (int i = range.begin(); i < range.end(); ++i) {
-	            DenseView<IteratorType, RealType> x(IteratorType(hX, index), hNtoK[i], hNtoK[i+1]);
-	            int numSubjects = hNtoK[i+1] - hNtoK[i];
-	            int numCases = hNWeight[i];
-	            std::vector<RealType> value = computeHowardRecursion<RealType>(offsExpXBeta.begin() + hNtoK[i], x, numSubjects, numCases);
-	            if (value[0]==0 || value[1] == 0 || value[2] == 0 || isinf(value[0]) || isinf(value[1]) || isinf(value[2])) {
-	                DenseView<IteratorType, RealType> newX(IteratorType(hX, index), hNtoK[i], hNtoK[i+1]);
-	                std::vector<DDouble> value = computeHowardRecursion<DDouble>(offsExpXBeta.begin() + hNtoK[i], newX, numSubjects, numCases);//, threadPool);//, hY.begin() + hNtoK[i]);
-	                using namespace sugar;
-	                //mutex0.lock();
-	                newGrad.local() -= (RealType)(-value[1]/value[0]);
-	                newHess.local() -= (RealType)((value[1]/value[0]) * (value[1]/value[0]) - value[2]/value[0]);
-	                //mutex0.unlock();
-	                continue;
-	            }
-	            //mutex0.lock();
-	            newGrad.local() -= (RealType)(-value[1]/value[0]);
-	            newHess.local() -= (RealType)((value[1]/value[0]) * (value[1]/value[0]) - value[2]/value[0]);
-	            //mutex0.unlock();
-	        }
-	    };
-	    tbb::parallel_for(tbb::blocked_range<int>(0,N),func);
-	    gradient += newGrad.combine([](const RealType& x, const RealType& y) {return x+y;});
-	    hessian += newHess.combine([](const RealType& x, const RealType& y) {return x+y;});
-#else
+template <class BaseModel,typename RealType>
+inline void ModelSpecifics<BaseModel,RealType>::computeLaneStatistics(int k) {
+    if (BaseModel::likelihoodHasDenominator) { // Compile-time switch
+        const int lanes = laneCount;
+        const RealType* y = &laneY[k * lanes];
+        const RealType* xBeta = &laneXBeta[k * lanes];
+        RealType* offsExpXBeta = &laneOffsExpXBeta[k * lanes];
+        RealType* denominator = &laneDenominator[k * lanes];
+        for (int l = 0; l < lanes; ++l) {
+            offsExpXBeta[l] = BaseModel::getOffsExpXBeta(hOffs.data(), xBeta[l], y[l], k);
+            denominator[l] = BaseModel::getDenomNullValue() + offsExpXBeta[l]; // Each row is its own stratum
+        }
+    }
+}
 
-	    using std::isinf;
-
-	    for (int i=0; i<N; i++) {
-	    DenseView<IteratorType, RealType> x(IteratorType(hX, index), hNtoK[i], hNtoK[i+1]);
-	    int numSubjects = hNtoK[i+1] - hNtoK[i];
-	    int numCases = hNWeight[i];
-
-	    std::vector<RealType> value = computeHowardRecursion<RealType>(offsExpXBeta.begin() + hNtoK[i], x, numSubjects, numCases);//, threadPool);//, hY.begin() + hNtoK[i]);
-	    //std::cout<<" values" << i <<": "<<value[0]<<" | "<<value[1]<<" | "<<value[2];
-	    if (value[0]==0 || value[1] == 0 || value[2] == 0 || isinf(value[0]) || isinf(value[1]) || isinf(value[2])) {
-	    DenseView<IteratorType, RealType> newX(IteratorType(hX, index), hNtoK[i], hNtoK[i+1]);
-	    std::vector<DDouble> value = computeHowardRecursion<DDouble>(offsExpXBeta.begin() + hNtoK[i], newX, numSubjects, numCases);//, threadPool);//, hY.begin() + hNtoK[i]);
-	    using namespace sugar;
-	    gradient -= (RealType)(-value[1]/value[0]);
-	    hessian -= (RealType)((value[1]/value[0]) * (value[1]/value[0]) - value[2]/value[0]);
-	    continue;
-	    }
-	    //gradient -= (RealType)(value[3] - value[1]/value[0]);
-	    gradient -= (RealType)(-value[1]/value[0]);
-	    hessian -= (RealType)((value[1]/value[0]) * (value[1]/value[0]) - value[2]/value[0]);
-	    }
-#endif // USE_RCPP_PARALLEL
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::computeGradientAndHessianLanes(int index, double* gradient,
+        double* hessian, bool useWeights) {
 
-	} else {
+    if (!BaseModel::hasIndependentRows) {
+        throw new std::logic_error("Lanes are only implemented for models with independent rows");
+    }
 
-// 	    auto rangeKey = helper::dependent::getRangeKey(
-// 	        hX, index, hPid,
-//             typename IteratorType::tag());
-//
-// 	    auto rangeXNumerator = helper::dependent::getRangeX(
-// 	        hX, index, offsExpXBeta,
-//             typename IteratorType::tag());
-//
-// 	    auto rangeGradient = helper::dependent::getRangeGradient(
-// 	        sparseIndices[index].get(), N, // runtime error: reference binding to null pointer of type 'struct vector'
-//             denomPid, hNWeight,
-//             typename IteratorType::tag());
-//
-// 	    const auto result = variants::trial::nested_reduce(
-// 	        rangeKey.begin(), rangeKey.end(), // key
-// 	        rangeXNumerator.begin(), // inner
-// 	        rangeGradient.begin(), // outer
-// 	        std::pair<RealType,RealType>{0,0}, Fraction<RealType>{0,0},
-// 	        TestNumeratorKernel<BaseModel,IteratorType,RealType>(), // Inner transform-reduce
-// 	        TestGradientKernel<BaseModel,IteratorType,Weights,RealType>()); // Outer transform-reduce
-//
-// 	    gradient = result.real();
+    switch (hX.getFormatType(index)) {
+        case INDICATOR :
+            useWeights ?
+            computeGradientAndHessianLanesImpl<IndicatorIterator<RealType>>(index, gradient, hessian, weighted) :
+            computeGradientAndHessianLanesImpl<IndicatorIterator<RealType>>(index, gradient, hessian, unweighted);
+            break;
+        case SPARSE :
+            useWeights ?
+            computeGradientAndHessianLanesImpl<SparseIterator<RealType>>(index, gradient, hessian, weighted) :
+            computeGradientAndHessianLanesImpl<SparseIterator<RealType>>(index, gradient, hessian, unweighted);
+            break;
+        case DENSE :
+            useWeights ?
+            computeGradientAndHessianLanesImpl<DenseIterator<RealType>>(index, gradient, hessian, weighted) :
+            computeGradientAndHessianLanesImpl<DenseIterator<RealType>>(index, gradient, hessian, unweighted);
+            break;
+        case INTERCEPT :
+            useWeights ?
+            computeGradientAndHessianLanesImpl<InterceptIterator<RealType>>(index, gradient, hessian, weighted) :
+            computeGradientAndHessianLanesImpl<InterceptIterator<RealType>>(index, gradient, hessian, unweighted);
+            break;
+    }
+}
+
+template <class BaseModel,typename RealType> template <class IteratorType, class Weights>
+void ModelSpecifics<BaseModel,RealType>::computeGradientAndHessianLanesImpl(int index, double *ogradient,
+        double *ohessian, Weights w) {
+
+    // One pass over column index serves every lane
+    const int lanes = laneCount;
+    RealType* gradient = laneGradient.data();
+    RealType* hessian = laneHessian.data();
+    std::fill(gradient, gradient + lanes, static_cast<RealType>(0));
+    std::fill(hessian, hessian + lanes, static_cast<RealType>(0));
+
+    for (IteratorType it(hX, index); it; ++it) {
+        const int i = it.index();
+        const RealType x = it.value();
+        const RealType* y = &laneY[i * lanes];
+        const RealType weight = hNWeight[i];
+        const RealType* xBeta = &laneXBeta[i * lanes];
+        const RealType* offsExpXBeta = &laneOffsExpXBeta[i * lanes];
+        const RealType* denominator = &laneDenominator[i * lanes];
+
+        for (int l = 0; l < lanes; ++l) {
+            const RealType numerator1 = BaseModel::gradientNumeratorContrib(x, offsExpXBeta[l], xBeta[l], y[l]);
+            const RealType numerator2 = (!IteratorType::isIndicator && BaseModel::hasTwoNumeratorTerms) ?
+                    BaseModel::gradientNumerator2Contrib(x, offsExpXBeta[l]) : static_cast<RealType>(0);
+
+            // Compile-time delegation
+            BaseModel::incrementGradientAndHessian(it,
+                    w, // Signature-only, for iterator-type specialization
+                    &gradient[l], &hessian[l], numerator1, numerator2,
+                    denominator[l], weight, x, xBeta[l], y[l]); // When function is in-lined, compiler will only use necessary arguments
+        }
+    }
+
+    for (int l = 0; l < lanes; ++l) {
+        if (BaseModel::precomputeGradient) { // Compile-time switch
+            gradient[l] -= laneXjY[index * lanes + l];
+        }
+        if (BaseModel::precomputeHessian) { // Compile-time switch
+            hessian[l] += static_cast<RealType>(2.0) * hXjX[index];
+        }
+        ogradient[l] = static_cast<double>(gradient[l]);
+        ohessian[l] = static_cast<double>(hessian[l]);
+    }
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::updateXBetaLanes(int index, const double* delta) {
+    switch (hX.getFormatType(index)) {
+        case INDICATOR :
+            updateXBetaLanesImpl<IndicatorIterator<RealType>>(delta, index);
+            break;
+        case SPARSE :
+            updateXBetaLanesImpl<SparseIterator<RealType>>(delta, index);
+            break;
+        case DENSE :
+            updateXBetaLanesImpl<DenseIterator<RealType>>(delta, index);
+            break;
+        case INTERCEPT :
+            updateXBetaLanesImpl<InterceptIterator<RealType>>(delta, index);
+            break;
+    }
+}
+
+template <class BaseModel,typename RealType> template <class IteratorType>
+void ModelSpecifics<BaseModel,RealType>::updateXBetaLanesImpl(const double* delta, int index) {
+    const int lanes = laneCount;
+    for (IteratorType it(hX, index); it; ++it) {
+        const int k = it.index();
+        const RealType x = it.value();
+        const RealType* y = &laneY[k * lanes];
+        RealType* xBeta = &laneXBeta[k * lanes];
+        RealType* offsExpXBeta = &laneOffsExpXBeta[k * lanes];
+        RealType* denominator = &laneDenominator[k * lanes];
+        for (int l = 0; l < lanes; ++l) {
+            if (delta[l] != 0.0) { // Converged lanes are left alone
+                xBeta[l] += static_cast<RealType>(delta[l]) * x;
+                if (BaseModel::likelihoodHasDenominator) { // Compile-time switch
+                    offsExpXBeta[l] = BaseModel::getOffsExpXBeta(hOffs.data(), xBeta[l], y[l], k);
+                    denominator[l] = BaseModel::getDenomNullValue() + offsExpXBeta[l];
+                }
+            }
+        }
+    }
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::getGradientObjectiveLanes(double* objective, bool useWeights) {
+    const int lanes = laneCount;
+    std::vector<RealType> criterion(lanes, static_cast<RealType>(0));
+    for (size_t k = 0; k < K; ++k) {
+        const RealType* y = &laneY[k * lanes];
+        const RealType* xBeta = &laneXBeta[k * lanes];
+        for (int l = 0; l < lanes; ++l) {
+            criterion[l] += xBeta[l] * (useWeights ? y[l] * hKWeight[k] : y[l]);
+        }
+    }
+    for (int l = 0; l < lanes; ++l) {
+        objective[l] = static_cast<double>(criterion[l]);
+    }
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::getLogLikelihoodLanes(double* logLikelihood, bool useWeights) {
+
+    // As getLogLikelihood(); rows are their own strata, so hNWeight[k] already carries the row weight
+    const int lanes = laneCount;
+    const bool hasOffs = hOffs.size() > 0;
+    std::vector<RealType> sum(lanes, static_cast<RealType>(0));
+    for (size_t k = 0; k < K; ++k) {
+        const RealType weight = useWeights ? hKWeight[k] : static_cast<RealType>(1);
+        const RealType offs = hasOffs ? hOffs[k] : static_cast<RealType>(0);
+        const RealType* y = &laneY[k * lanes];
+        const RealType* xBeta = &laneXBeta[k * lanes];
+        const RealType* denominator = &laneDenominator[k * lanes];
+        for (int l = 0; l < lanes; ++l) {
+            sum[l] += BaseModel::logLikeNumeratorContrib(y[l], xBeta[l]) * weight;
+            if (BaseModel::likelihoodHasDenominator) { // Compile-time switch
+                sum[l] -= BaseModel::logLikeDenominatorContrib(hNWeight[k], denominator[l]);
+            }
+            if (BaseModel::likelihoodHasFixedTerms) { // Compile-time switch
+                sum[l] += BaseModel::logLikeFixedTermsContrib(y[l], offs, offs) * weight;
+            }
+        }
+    }
+    for (int l = 0; l < lanes; ++l) {
+        logLikelihood[l] = static_cast<double>(sum[l]);
+    }
+}
+
+template <class BaseModel,typename RealType>
+bool ModelSpecifics<BaseModel,RealType>::projectDualPoint(const std::vector<int>& unpenalized,
+        std::vector<double>& gradient, bool useWeights) {
+	refreshXBeta();
+
+    // Dual point is the negative per-row gradient (from the last computeGradient()); a feasible one must be
+    // orthogonal to every unpenalized column, so remove its least-squares fit on those columns
+    hDualResidual.assign(K, static_cast<RealType>(0));
+    if (!BaseModel::hasSafeScreening) { // Compile-time switch
+        return false;
+    }
+    for (size_t k = 0; k < K; ++k) {
+        const RealType weight = useWeights ? hNWeight[k] : static_cast<RealType>(1);
+        if (weight > static_cast<RealType>(0)) {
+            const RealType target = BaseModel::precomputeGradient ? weight * hY[k] : static_cast<RealType>(0);
+            hDualResidual[k] = target - hResidual[k];
+        }
+    }
+
+    const size_t m = unpenalized.size();
+    if (m == 0) {
+        return true;
+    }
+
+    // Unpenalized columns restricted to rows in the fit
+    std::vector<RealVector> columns(m, RealVector(K, static_cast<RealType>(0)));
+    for (size_t i = 0; i < m; ++i) {
+        for (GenericIterator<RealType> it(hX, unpenalized[i]); it; ++it) {
+            const int k = it.index();
+            if (!useWeights || hNWeight[k] > static_cast<RealType>(0)) {
+                columns[i][k] = it.value();
+            }
+        }
+    }
+
+    std::vector<double> gram(m * m, 0.0);
+    std::vector<double> coefficient(m, 0.0);
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t l = 0; l <= i; ++l) {
+            double sum = 0.0;
+            for (size_t k = 0; k < K; ++k) {
+                sum += columns[i][k] * columns[l][k];
+            }
+            gram[i * m + l] = gram[l * m + i] = sum;
+        }
+        for (size_t k = 0; k < K; ++k) {
+            coefficient[i] += columns[i][k] * hDualResidual[k];
+        }
+    }
+
+    // Cholesky solve; collinear unpenalized columns leave the projection undefined
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t l = 0; l < i; ++l) {
+            gram[i * m + i] -= gram[i * m + l] * gram[i * m + l];
+        }
+        if (!(gram[i * m + i] > 1E-12 * (1.0 + std::abs(gram[i * m + i])))) {
+            return false;
+        }
+        gram[i * m + i] = std::sqrt(gram[i * m + i]);
+        for (size_t r = i + 1; r < m; ++r) {
+            for (size_t l = 0; l < i; ++l) {
+                gram[r * m + i] -= gram[r * m + l] * gram[i * m + l];
+            }
+            gram[r * m + i] /= gram[i * m + i];
+        }
+    }
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t l = 0; l < i; ++l) {
+            coefficient[i] -= gram[i * m + l] * coefficient[l];
+        }
+        coefficient[i] /= gram[i * m + i];
+    }
+    for (size_t i = m; i-- > 0; ) {
+        for (size_t l = i + 1; l < m; ++l) {
+            coefficient[i] -= gram[l * m + i] * coefficient[l];
+        }
+        coefficient[i] /= gram[i * m + i];
+    }
+
+    for (size_t i = 0; i < m; ++i) {
+        const RealType c = static_cast<RealType>(coefficient[i]);
+        for (size_t k = 0; k < K; ++k) {
+            hDualResidual[k] -= c * columns[i][k];
+        }
+    }
+
+    // Gradient at the projected point, -x_j' rho
+    for (size_t j = 0; j < J; ++j) {
+        RealType sum = static_cast<RealType>(0);
+        for (GenericIterator<RealType> it(hX, j); it; ++it) {
+            sum += it.value() * hDualResidual[it.index()];
+        }
+        gradient[j] = -static_cast<double>(sum);
+    }
+    for (size_t i = 0; i < m; ++i) {
+        gradient[unpenalized[i]] = 0.0;
+    }
+    return true;
+}
+
+template <class BaseModel,typename RealType>
+double ModelSpecifics<BaseModel,RealType>::getDualObjective(double scale, bool useWeights) {
+	refreshXBeta();
+
+    // Dual point from the last projectDualPoint(), shrunk by scale
+    RealType dual = static_cast<RealType>(0);
+    if (BaseModel::hasSafeScreening) { // Compile-time switch
+        const RealType shrink = static_cast<RealType>(1.0 / scale);
+        for (size_t k = 0; k < K; ++k) {
+            const RealType weight = useWeights ? hNWeight[k] : static_cast<RealType>(1);
+            if (weight > static_cast<RealType>(0)) {
+                dual += BaseModel::dualObjectiveContrib(hY[k], hDualResidual[k] * shrink, weight);
+            }
+        }
+    }
+    return static_cast<double>(dual);
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::computeCurvatureNorms(std::vector<double>& norms, bool useWeights) {
+
+    norms.resize(J);
+    for (size_t j = 0; j < J; ++j) {
+        switch (hX.getFormatType(j)) {
+            case INDICATOR :
+                norms[j] = computeCurvatureNormImpl<IndicatorIterator<RealType>>(j, useWeights);
+                break;
+            case SPARSE :
+                norms[j] = computeCurvatureNormImpl<SparseIterator<RealType>>(j, useWeights);
+                break;
+            case DENSE :
+                norms[j] = computeCurvatureNormImpl<DenseIterator<RealType>>(j, useWeights);
+                break;
+            case INTERCEPT :
+                norms[j] = computeCurvatureNormImpl<InterceptIterator<RealType>>(j, useWeights);
+                break;
+        }
+    }
+}
+
+template <class BaseModel,typename RealType> template <class IteratorType>
+double ModelSpecifics<BaseModel,RealType>::computeCurvatureNormImpl(int index, bool useWeights) {
+
+    // Sum_k L_k x_kj^2, with L_k bounding the curvature of row k
+    RealType norm = static_cast<RealType>(0);
+    for (IteratorType it(hX, index); it; ++it) {
+        const RealType x = it.value();
+        norm += (useWeights ? hNWeight[it.index()] : static_cast<RealType>(1)) * x * x;
+    }
+    return static_cast<double>(BaseModel::getCurvatureBound() * norm);
+}
+
+template <class BaseModel,typename RealType> template <class IteratorType>
+void ModelSpecifics<BaseModel,RealType>::computeQuadraticGradientAndHessianImpl(
+        int index, double *ogradient, double *ohessian) {
+
+    // Second-order expansion about the anchor: r_k + w_k (xBeta_k - anchor_k) per row
+    RealType gradient = static_cast<RealType>(0);
+    RealType hessian = static_cast<RealType>(0);
+
+    for (IteratorType it(hX, index); it; ++it) {
+        const int k = it.index();
+        const RealType x = it.value();
+        const RealType w = hWorkingWeight[k];
+        gradient += x * (hResidual[k] + w * (hXBeta[k] - hXBetaAnchor[k]));
+        hessian += x * x * w;
+    }
+
+    if (BaseModel::precomputeGradient) { // Compile-time switch
+        gradient -= hXjY[index];
+    }
+
+    *ogradient = static_cast<double>(gradient);
+    *ohessian = static_cast<double>(hessian);
+}
+
+template <class BaseModel,typename RealType> template <class IteratorType>
+void ModelSpecifics<BaseModel,RealType>::computeTransposeProductImpl(
+        std::vector<double>& gradient, int threads) {
+
+    auto accumulate = [this](int begin, int end, std::vector<RealType>& out) {
+        for (int k = begin; k < end; ++k) {
+            const RealType r = hResidual[k];
+            if (r != static_cast<RealType>(0)) {
+                IteratorType it(*hXt, k);
+                for (; it; ++it) {
+                    out[it.index()] += it.value() * r;
+                }
+            }
+        }
+    };
+
+    const size_t minRowsPerThread = 1000;
+    const int nThreads = std::max(1, std::min(threads,
+                                              static_cast<int>(K / minRowsPerThread)));
+
+    // Each thread scatters into its own buffer; buffers are reduced in fixed order
+    std::vector<std::vector<RealType>> partial(nThreads, std::vector<RealType>(J, static_cast<RealType>(0)));
+
+    if (nThreads == 1) {
+        accumulate(0, K, partial[0]);
+    } else {
+        ThreadPool& pool = getStrataPool(nThreads - 1);
+        const int chunkSize = K / nThreads;
+        std::vector<std::future<void>> futures;
+        for (int t = 1; t < nThreads; ++t) {
+            const int begin = t * chunkSize;
+            const int end = (t == nThreads - 1) ? K : begin + chunkSize;
+            futures.push_back(pool.enqueue([&accumulate,&partial,begin,end,t]() {
+                accumulate(begin, end, partial[t]);
+            }));
+        }
+        accumulate(0, chunkSize, partial[0]);
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+
+    for (size_t j = 0; j < J; ++j) {
+        RealType sum = static_cast<RealType>(0);
+        for (int t = 0; t < nThreads; ++t) {
+            sum += partial[t][j];
+        }
+        gradient[j] = static_cast<double>(sum);
+    }
+}
+
+template <class BaseModel,typename RealType> template <class IteratorType, class Weights>
+void ModelSpecifics<BaseModel,RealType>::computeGradientAndHessianImpl(int index, double *ogradient,
+		double *ohessian, Weights w) {
+
+#ifdef CYCLOPS_DEBUG_TIMING
+#ifdef CYCLOPS_DEBUG_TIMING_LOW
+	auto start = bsccs::chrono::steady_clock::now();
+#endif
+#endif
+
+	RealType gradient = static_cast<RealType>(0);
+	RealType hessian = static_cast<RealType>(0);
+
+    if (BaseModel::cumulativeGradientAndHessian) { // Compile-time switch
+
+    	if (sparseIndices[index] == nullptr || sparseIndices[index]->size() > 0) {
+
+    	    IteratorType it(sparseIndices[index].get(), N);
+
+    	    RealType accNumerPid  = static_cast<RealType>(0);
+    	    RealType accNumerPid2 = static_cast<RealType>(0);
+
+    	    // find start relavent accumulator reset point
+    	    auto reset = begin(accReset);
+    	    while( *reset < it.index() ) {
+    	        ++reset;
+    	    }
+
+    	    for (; it; ) {
+    	        int i = it.index();
+
+    	        if (*reset <= i) {
+    	            accNumerPid  = static_cast<RealType>(0.0);
+    	            accNumerPid2 = static_cast<RealType>(0.0);
+    	            ++reset;
+    	        }
+
+    	        const auto numerator1 = numerPid[i];
+    	        const auto numerator2 = numerPid2[i];
+
+    	        accNumerPid += numerator1;
+    	        accNumerPid2 += numerator2;
+
+    	        // Compile-time delegation
+    	        BaseModel::incrementGradientAndHessian(it,
+                        w, // Signature-only, for iterator-type specialization
+                        &gradient, &hessian, accNumerPid, accNumerPid2,
+                        accDenomPid[i], hNWeight[i], 0.0, hXBeta[i], hY[i]); // When function is in-lined, compiler will only use necessary arguments
+
+    	        ++it;
+
+    	        if (IteratorType::isSparse) {
+
+    	            const int next = it ? it.index() : N;
+    	            for (++i; i < next; ++i) {
+
+    	                if (*reset <= i) {
+    	                    accNumerPid  = static_cast<RealType>(0.0);
+    	                    accNumerPid2 = static_cast<RealType>(0.0);
+    	                    ++reset;
+    	                }
+
+    	                BaseModel::incrementGradientAndHessian(it,
+                                w, // Signature-only, for iterator-type specialization
+    	                        &gradient, &hessian, accNumerPid, accNumerPid2,
+    	                        accDenomPid[i], hNWeight[i], static_cast<RealType>(0), hXBeta[i], hY[i]); // When function is in-lined, compiler will only use necessary arguments
+    	            }
+    	        }
+    	    }
+		}
+
+	} else if (BaseModel::hasIndependentRows) {
+
+	    IteratorType it(hX, index);
+
+	    for (; it; ++it) {
+	        const int i = it.index();
+
+	        RealType numerator1 = BaseModel::gradientNumeratorContrib(it.value(), offsExpXBeta[i], hXBeta[i], hY[i]);
+	        RealType numerator2 = (!IteratorType::isIndicator && BaseModel::hasTwoNumeratorTerms) ?
+	                BaseModel::gradientNumerator2Contrib(it.value(), offsExpXBeta[i]) : static_cast<RealType>(0);
+
+	        // Compile-time delegation
+	        BaseModel::incrementGradientAndHessian(it,
+                    w, // Signature-only, for iterator-type specialization
+                    &gradient, &hessian, numerator1, numerator2,
+                    denomPid[i], hNWeight[i], it.value(), hXBeta[i], hY[i]); // When function is in-lined, compiler will only use necessary arguments
+	    }
+
+	} else if (BaseModel::exactCLR) {
+
+	    // Contributions of stratum i
+	    auto stratum = [this,index](int i, RealType& g, RealType& h) {
+	        DenseView<IteratorType, RealType> x(IteratorType(hX, index), hNtoK[i], hNtoK[i+1]);
+	        int numSubjects = hNtoK[i+1] - hNtoK[i];
+	        int numCases = hNWeight[i];
+
+	        std::vector<RealType> value = computeHowardRecursion<RealType>(offsExpXBeta.begin() + hNtoK[i], x, numSubjects, numCases);
+	        g = -value[1]/value[0];
+	        h = (value[1]/value[0]) * (value[1]/value[0]) - value[2]/value[0];
+	    };
+
+	    const size_t minRowsPerThread = 1000;
+	    const int nThreads = std::max(1, std::min(std::min(threadCount, static_cast<int>(N)),
+	                                              static_cast<int>(K / minRowsPerThread)));
+
+	    if (nThreads == 1) {
+	        for (int i = 0; i < static_cast<int>(N); ++i) {
+	            RealType g, h;
+	            stratum(i, g, h);
+	            gradient -= g;
+	            hessian -= h;
+	        }
+	    } else {
+	        if (strataBySize.size() != N) {
+	            strataBySize.resize(N);
+	            std::iota(strataBySize.begin(), strataBySize.end(), 0);
+	            std::stable_sort(strataBySize.begin(), strataBySize.end(), [this](int lhs, int rhs) {
+	                return hNtoK[lhs + 1] - hNtoK[lhs] > hNtoK[rhs + 1] - hNtoK[rhs];
+	            });
+	        }
+	        ThreadPool& pool = getStrataPool(nThreads - 1);
+	        stratumGradient.resize(N);
+	        stratumHessian.resize(N);
+
+	        // Large strata dominate, so threads claim the next-largest stratum as they free up
+	        std::atomic<int> next(0);
+	        auto work = [this,&stratum,&next]() {
+	            for (int t = next++; t < static_cast<int>(N); t = next++) {
+	                const int i = strataBySize[t];
+	                stratum(i, stratumGradient[i], stratumHessian[i]);
+	            }
+	        };
+
+	        std::vector<std::future<void>> futures;
+	        for (int t = 1; t < nThreads; ++t) {
+	            futures.push_back(pool.enqueue(work));
+	        }
+	        work();
+	        for (auto& future : futures) {
+	            future.get();
+	        }
+
+	        // Reduce in stratum order, as the serial loop does
+	        for (int i = 0; i < static_cast<int>(N); ++i) {
+	            gradient -= stratumGradient[i];
+	            hessian -= stratumHessian[i];
+	        }
+	    }
+
+	} else {
+
+// 	    auto rangeKey = helper::dependent::getRangeKey(
+// 	        hX, index, hPid,
+//             typename IteratorType::tag());
+//
+// 	    auto rangeXNumerator = helper::dependent::getRangeX(
+// 	        hX, index, offsExpXBeta,
+//             typename IteratorType::tag());
+//
+// 	    auto rangeGradient = helper::dependent::getRangeGradient(
+// 	        sparseIndices[index].get(), N, // runtime error: reference binding to null pointer of type 'struct vector'
+//             denomPid, hNWeight,
+//             typename IteratorType::tag());
+//
+// 	    const auto result = variants::trial::nested_reduce(
+// 	        rangeKey.begin(), rangeKey.end(), // key
+// 	        rangeXNumerator.begin(), // inner
+// 	        rangeGradient.begin(), // outer
+// 	        std::pair<RealType,RealType>{0,0}, Fraction<RealType>{0,0},
+// 	        TestNumeratorKernel<BaseModel,IteratorType,RealType>(), // Inner transform-reduce
+// 	        TestGradientKernel<BaseModel,IteratorType,Weights,RealType>()); // Outer transform-reduce
+//
+// 	    gradient = result.real();
 // 	    hessian = result.imag();
 
         using RealTypePair = std::pair<RealType, RealType>;
@@ -1110,10 +1940,11 @@ void ModelSpecifics<BaseModel,RealType>::computeGradientAndHessianImpl(int index
 template <class BaseModel,typename RealType>
 void ModelSpecifics<BaseModel,RealType>::computeFisherInformation(int indexOne, int indexTwo,
 		double *oinfo, bool useWeights) {
+	refreshXBeta();
 
-	if (useWeights) {
+	if (useWeights && !BaseModel::hasIndependentRows) {
 		throw new std::logic_error("Weights are not yet implemented in Fisher Information calculations");
-	} else { // no weights
+	} else { // weights enter through hKWeight, which is 1 when unweighted
 		switch (hX.getFormatType(indexOne)) {
 			case INDICATOR :
 				dispatchFisherInformation<IndicatorIterator<RealType>>(indexOne, indexTwo, oinfo, weighted);
@@ -1152,15 +1983,17 @@ void ModelSpecifics<BaseModel,RealType>::dispatchFisherInformation(int indexOne,
 
 
 template<class BaseModel, typename RealType> template<class IteratorType>
-SparseIterator<RealType> ModelSpecifics<BaseModel, RealType>::getSubjectSpecificHessianIterator(int index) {
+typename ModelSpecifics<BaseModel, RealType>::CDCPtr ModelSpecifics<BaseModel, RealType>::getSubjectSpecificHessianTerms(int index) {
+
+	hessianSparseCrossTerms.validate(xBetaVersion);
+	CDCPtr column = hessianSparseCrossTerms.find(index);
 
-	if (hessianSparseCrossTerms.find(index) == hessianSparseCrossTerms.end()) {
+	if (!column) {
 
         auto indices = make_shared<std::vector<int> >();
         auto values = make_shared<std::vector<RealType> >();
 
-    	CDCPtr column = bsccs::make_shared<CompressedDataColumn<RealType>>(indices, values, SPARSE);
-		hessianSparseCrossTerms.insert(std::make_pair(index, column));
+    	column = bsccs::make_shared<CompressedDataColumn<RealType>>(indices, values, SPARSE);
 
 		IteratorType itCross(hX, index);
 		for (; itCross;) {
@@ -1175,9 +2008,11 @@ SparseIterator<RealType> ModelSpecifics<BaseModel, RealType>::getSubjectSpecific
 			indices->push_back(currentPid);
 			values->push_back(value);
 		}
-	}
-	return SparseIterator<RealType>(*hessianSparseCrossTerms[index]);
 
+		hessianSparseCrossTerms.insert(index, column,
+				indices->size() * (sizeof(int) + sizeof(RealType)));
+	}
+	return column;
 }
 
 template <class BaseModel, typename RealType> template <class IteratorTypeOne, class IteratorTypeTwo, class Weights>
@@ -1241,8 +2076,11 @@ void ModelSpecifics<BaseModel,RealType>::computeFisherInformationImpl(int indexO
 		}
 		information -= cross;
 #else
-		SparseIterator<RealType> sparseCrossOneTerms = getSubjectSpecificHessianIterator<IteratorTypeOne>(indexOne);
-		SparseIterator<RealType> sparseCrossTwoTerms = getSubjectSpecificHessianIterator<IteratorTypeTwo>(indexTwo);
+		// Hold both columns, as fetching the second may evict the first
+		CDCPtr crossOneTerms = getSubjectSpecificHessianTerms<IteratorTypeOne>(indexOne);
+		CDCPtr crossTwoTerms = getSubjectSpecificHessianTerms<IteratorTypeTwo>(indexTwo);
+		SparseIterator<RealType> sparseCrossOneTerms(*crossOneTerms);
+		SparseIterator<RealType> sparseCrossTwoTerms(*crossTwoTerms);
 		PairProductIterator<SparseIterator<RealType>,SparseIterator<RealType>,RealType> itSparseCross(sparseCrossOneTerms, sparseCrossTwoTerms);
 
 		RealType sparseCross = static_cast<RealType>(0);
@@ -1257,6 +2095,410 @@ void ModelSpecifics<BaseModel,RealType>::computeFisherInformationImpl(int indexO
 	*oinfo = static_cast<double>(information);
 }
 
+template<class BaseModel, typename RealType>
+typename ModelSpecifics<BaseModel, RealType>::CDCPtr ModelSpecifics<BaseModel, RealType>::getSubjectSpecificHessianTerms(int index) {
+	switch (hX.getFormatType(index)) {
+		case INDICATOR :
+			return getSubjectSpecificHessianTerms<IndicatorIterator<RealType>>(index);
+		case SPARSE :
+			return getSubjectSpecificHessianTerms<SparseIterator<RealType>>(index);
+		case DENSE :
+			return getSubjectSpecificHessianTerms<DenseIterator<RealType>>(index);
+		default :
+			return getSubjectSpecificHessianTerms<InterceptIterator<RealType>>(index);
+	}
+}
+
+template <class BaseModel,typename RealType>
+void ModelSpecifics<BaseModel,RealType>::computeFisherInformationMatrix(const std::vector<int>& indices,
+		double *oinfo, bool useWeights, int threads) {
+	refreshXBeta();
+
+	if (useWeights && !BaseModel::hasIndependentRows) {
+		throw new std::logic_error("Weights are not yet implemented in Fisher Information calculations");
+	}
+
+	if (!hXt) {
+		initializeMmXt();
+	}
+
+	switch (hXt->getFormatType(0)) {
+		case INDICATOR :
+			computeFisherInformationMatrixImpl<IndicatorIterator<RealType>>(indices, oinfo, threads);
+			break;
+		case SPARSE :
+			computeFisherInformationMatrixImpl<SparseIterator<RealType>>(indices, oinfo, threads);
+			break;
+		default :
+			computeFisherInformationMatrixImpl<DenseIterator<RealType>>(indices, oinfo, threads);
+			break;
+	}
+}
+
+template <class BaseModel, typename RealType> template <class IteratorType>
+void ModelSpecifics<BaseModel,RealType>::computeFisherInformationMatrixImpl(const std::vector<int>& indices,
+		double *oinfo, int threads) {
+
+	// Fills the column-major P x P information for the requested columns in one sweep over the
+	// rows of X^T, instead of one pair-product walk (and cross-term lookup) per entry
+	const int P = static_cast<int>(indices.size());
+	std::fill(oinfo, oinfo + static_cast<size_t>(P) * P, 0.0);
+	if (P == 0) {
+		return;
+	}
+
+	std::vector<int> position(J, -1);
+	for (int a = 0; a < P; ++a) {
+		if (position[indices[a]] == -1) {
+			position[indices[a]] = a;
+		}
+	}
+
+	// Per-row curvature w_k, so that entry (a, b) is sum_k w_k x_ak x_bk (less strata cross terms)
+	struct UnitValue {
+		RealType value() const { return static_cast<RealType>(1); }
+	} unit;
+
+	RealVector rowWeight(K);
+	for (size_t k = 0; k < K; ++k) {
+		RealType w = static_cast<RealType>(0);
+		BaseModel::incrementFisherInformation(unit, weighted, &w,
+				offsExpXBeta[k], 0.0, 0.0,
+				denomPid[BaseModel::getGroup(hPid, k)],
+				hKWeight[k], static_cast<RealType>(1), hXBeta[k], hY[k]);
+		rowWeight[k] = w;
+	}
+
+	// Per-stratum cross terms of each requested column are built once and shared by all pairs
+	std::vector<std::vector<std::pair<int,RealType>>> strata;
+	if (BaseModel::hasStrataCrossTerms) {
+		strata.resize(N);
+		for (int a = 0; a < P; ++a) {
+			if (position[indices[a]] == a) {
+				const CDCPtr terms = getSubjectSpecificHessianTerms(indices[a]);
+				for (SparseIterator<RealType> it(*terms); it; ++it) {
+					strata[it.index()].emplace_back(a, it.value());
+				}
+			}
+		}
+	}
+
+	// Requested entries of each weighted row, gathered in one pass over X^T and sorted by position,
+	// so that a tile visits only the entries it owns
+	std::vector<size_t> rowStart(1, 0);
+	std::vector<std::pair<int,RealType>> rowEntries;
+	std::vector<RealType> rowWeights;
+	for (size_t k = 0; k < K; ++k) {
+		const RealType w = rowWeight[k];
+		if (w == static_cast<RealType>(0)) {
+			continue;
+		}
+		const size_t start = rowEntries.size();
+		for (IteratorType it(*hXt, k); it; ++it) {
+			const int a = position[it.index()];
+			if (a != -1) {
+				rowEntries.emplace_back(a, it.value());
+			}
+		}
+		if (rowEntries.size() == start) {
+			continue;
+		}
+		std::sort(rowEntries.begin() + start, rowEntries.end());
+		rowStart.push_back(rowEntries.size());
+		rowWeights.push_back(w);
+	}
+
+	// Each tile owns a contiguous range of output columns b and fills rows a <= b
+	auto byPosition = [](const std::pair<int,RealType>& entry, int b) {
+		return entry.first < b;
+	};
+	auto accumulate = [P,&rowStart,&rowEntries,&rowWeights,&strata,&byPosition,this,oinfo](int begin, int end) {
+		for (size_t r = 0; r < rowWeights.size(); ++r) {
+			const auto first = rowEntries.begin() + rowStart[r];
+			const auto last = rowEntries.begin() + rowStart[r + 1];
+			const RealType w = rowWeights[r];
+			for (auto entryB = std::lower_bound(first, last, begin, byPosition);
+					entryB != last && entryB->first < end; ++entryB) {
+				const int b = entryB->first;
+				double* column = oinfo + static_cast<size_t>(b) * P;
+				const RealType wb = w * entryB->second;
+				for (auto entryA = first; entryA != entryB + 1; ++entryA) {
+					column[entryA->first] += wb * entryA->second;
+				}
+			}
+		}
+
+		for (size_t n = 0; n < strata.size(); ++n) {
+			const auto& stratum = strata[n];
+			if (stratum.empty()) {
+				continue;
+			}
+			const RealType denom = denomPid[n] * denomPid[n];
+			for (auto entryB = std::lower_bound(stratum.begin(), stratum.end(), begin, byPosition);
+					entryB != stratum.end() && entryB->first < end; ++entryB) {
+				const int b = entryB->first;
+				double* column = oinfo + static_cast<size_t>(b) * P;
+				const RealType vb = entryB->second / denom;
+				for (auto entryA = stratum.begin(); entryA != entryB + 1; ++entryA) {
+					column[entryA->first] -= entryA->second * vb;
+				}
+			}
+		}
+	};
+
+	const int minColumnsPerTile = 64;
+	const int nThreads = std::max(1, std::min(threads, P / minColumnsPerTile));
+
+	if (nThreads == 1) {
+		accumulate(0, P);
+	} else {
+		// Tile boundaries split the upper triangle into equal areas; threads claim the next tile as they free up
+		const int nTiles = std::min(4 * nThreads, P / minColumnsPerTile);
+		std::vector<int> boundary(nTiles + 1);
+		for (int t = 0; t <= nTiles; ++t) {
+			boundary[t] = static_cast<int>(P * std::sqrt(static_cast<double>(t) / nTiles));
+		}
+		boundary[nTiles] = P;
+
+		ThreadPool& pool = getStrataPool(nThreads - 1);
+		std::atomic<int> next(0);
+		auto work = [&accumulate,&boundary,&next,nTiles]() {
+			for (int t = next++; t < nTiles; t = next++) {
+				accumulate(boundary[t], boundary[t + 1]);
+			}
+		};
+
+		std::vector<std::future<void>> futures;
+		for (int t = 1; t < nThreads; ++t) {
+			futures.push_back(pool.enqueue(work));
+		}
+		work();
+		for (auto& future : futures) {
+			future.get();
+		}
+	}
+
+	// Mirror the upper triangle, then copy any repeated requests from their first occurrence
+	for (int b = 0; b < P; ++b) {
+		for (int a = 0; a < b; ++a) {
+			oinfo[static_cast<size_t>(a) * P + b] = oinfo[static_cast<size_t>(b) * P + a];
+		}
+	}
+	for (int a = 0; a < P; ++a) {
+		const int first = position[indices[a]];
+		if (first != a) {
+			for (int b = 0; b < P; ++b) {
+				const int source = position[indices[b]];
+				oinfo[static_cast<size_t>(b) * P + a] = oinfo[static_cast<size_t>(source) * P + first];
+				oinfo[static_cast<size_t>(a) * P + b] = oinfo[static_cast<size_t>(first) * P + source];
+			}
+		}
+	}
+}
+
+template <class BaseModel,typename RealType>
+double ModelSpecifics<BaseModel,RealType>::getApproximateLeaveOutLogLikelihood(const std::vector<int>& indices,
+		const double *inverseInformation, int threads) {
+	refreshXBeta();
+
+	// Requires groups that enter the likelihood separately: single rows, or strata of conditional models
+	const bool separable = BaseModel::hasIndependentRows ||
+			(BaseModel::hasNtoKIndices && !BaseModel::exactTies);
+	if (!separable) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	if (!hXt) {
+		initializeMmXt();
+	}
+
+	RealVector leaveOutXBeta(hXBeta);
+
+	switch (hXt->getFormatType(0)) {
+		case INDICATOR :
+			computeLeaveOutXBetaImpl<IndicatorIterator<RealType>>(indices, inverseInformation, threads, leaveOutXBeta);
+			break;
+		case SPARSE :
+			computeLeaveOutXBetaImpl<SparseIterator<RealType>>(indices, inverseInformation, threads, leaveOutXBeta);
+			break;
+		default :
+			computeLeaveOutXBetaImpl<DenseIterator<RealType>>(indices, inverseInformation, threads, leaveOutXBeta);
+			break;
+	}
+
+	// Each group's contribution depends only on its own linear predictors, so all are scored at once
+	hXBeta.swap(leaveOutXBeta);
+	computeRemainingStatistics(false);
+	const double logLikelihood = getLogLikelihood(false);
+
+	hXBeta.swap(leaveOutXBeta);
+	computeRemainingStatistics(false);
+
+	return logLikelihood;
+}
+
+template <class BaseModel, typename RealType> template <class IteratorType>
+void ModelSpecifics<BaseModel,RealType>::computeLeaveOutXBetaImpl(const std::vector<int>& indices,
+		const double *inverseInformation, int threads, RealVector& leaveOutXBeta) {
+
+	const int P = static_cast<int>(indices.size());
+	std::vector<int> position(J, -1);
+	for (int a = 0; a < P; ++a) {
+		position[indices[a]] = a;
+	}
+
+	// Derivatives of each row's negative log-likelihood in xBeta; within a stratum the
+	// curvature is diag(curvature) - share share^T
+	RealVector gradient(K);
+	RealVector curvature(K);
+	RealVector share;
+	if (BaseModel::hasIndependentRows) {
+		computeResidualImpl<UnweightedOperation>();
+		const bool glm = std::is_base_of<GLMProjection, BaseModel>::value;
+		for (size_t k = 0; k < K; ++k) {
+			// Least-squares residuals are already derivatives in xBeta, with constant curvature
+			gradient[k] = glm ? hResidual[k] - hY[k] : hResidual[k];
+			curvature[k] = glm ? hWorkingWeight[k] :
+					static_cast<RealType>(BaseModel::getFisherInformationScale());
+		}
+	} else {
+		share.resize(K);
+		for (size_t k = 0; k < K; ++k) {
+			const int n = hPid[k];
+			const RealType probability = offsExpXBeta[k] / denomPid[n];
+			gradient[k] = hNWeight[n] * probability - hY[k];
+			curvature[k] = hNWeight[n] * probability;
+			share[k] = std::sqrt(hNWeight[n]) * probability;
+		}
+	}
+
+	const int nGroups = BaseModel::hasIndependentRows ? static_cast<int>(K) : static_cast<int>(N);
+
+	// Leaving group s out moves its predictors by K_s (I - W_s K_s)^{-1} g_s, where K_s = X_s H^{-1} X_s^T
+	auto leaveOut = [this,P,&position,inverseInformation,&gradient,&curvature,&share,&leaveOutXBeta](int begin, int end) {
+
+		std::vector<std::vector<std::pair<int,double>>> rows;
+		std::vector<double> kernel;
+		std::vector<double> system;
+		std::vector<double> solution;
+
+		for (int s = begin; s < end; ++s) {
+			const int first = BaseModel::hasIndependentRows ? s : hNtoK[s];
+			const int last = BaseModel::hasIndependentRows ? s + 1 : hNtoK[s + 1];
+			const int n = last - first;
+
+			rows.resize(n);
+			for (int i = 0; i < n; ++i) {
+				rows[i].clear();
+				for (IteratorType it(*hXt, first + i); it; ++it) {
+					const int a = position[it.index()];
+					if (a != -1) {
+						rows[i].emplace_back(a, it.value());
+					}
+				}
+			}
+
+			kernel.assign(n * n, 0.0);
+			for (int i = 0; i < n; ++i) {
+				for (int j = i; j < n; ++j) {
+					double sum = 0.0;
+					for (const auto& entryA : rows[i]) {
+						const double* column = inverseInformation + static_cast<size_t>(entryA.first) * P;
+						for (const auto& entryB : rows[j]) {
+							sum += entryA.second * column[entryB.first] * entryB.second;
+						}
+					}
+					kernel[i * n + j] = kernel[j * n + i] = sum;
+				}
+			}
+
+			if (n == 1) {
+				const double weight = curvature[first] - (share.empty() ? 0.0 : share[first] * share[first]);
+				leaveOutXBeta[first] += kernel[0] * gradient[first] / (1.0 - weight * kernel[0]);
+				continue;
+			}
+
+			// system = I - (diag(curvature) - share share^T) K, row-major
+			system.assign(n * n, 0.0);
+			for (int j = 0; j < n; ++j) {
+				double projection = 0.0;
+				for (int l = 0; l < n; ++l) {
+					projection += share[first + l] * kernel[l * n + j];
+				}
+				for (int i = 0; i < n; ++i) {
+					system[i * n + j] = (i == j ? 1.0 : 0.0)
+						- curvature[first + i] * kernel[i * n + j]
+						+ share[first + i] * projection;
+				}
+			}
+
+			// Gaussian elimination with partial pivoting; strata are small
+			solution.assign(gradient.begin() + first, gradient.begin() + last);
+			for (int c = 0; c < n; ++c) {
+				int pivot = c;
+				for (int r = c + 1; r < n; ++r) {
+					if (std::abs(system[r * n + c]) > std::abs(system[pivot * n + c])) {
+						pivot = r;
+					}
+				}
+				if (pivot != c) {
+					for (int l = 0; l < n; ++l) {
+						std::swap(system[c * n + l], system[pivot * n + l]);
+					}
+					std::swap(solution[c], solution[pivot]);
+				}
+				for (int r = c + 1; r < n; ++r) {
+					const double factor = system[r * n + c] / system[c * n + c];
+					for (int l = c; l < n; ++l) {
+						system[r * n + l] -= factor * system[c * n + l];
+					}
+					solution[r] -= factor * solution[c];
+				}
+			}
+			for (int c = n - 1; c >= 0; --c) {
+				for (int l = c + 1; l < n; ++l) {
+					solution[c] -= system[c * n + l] * solution[l];
+				}
+				solution[c] /= system[c * n + c];
+			}
+
+			for (int i = 0; i < n; ++i) {
+				double delta = 0.0;
+				for (int j = 0; j < n; ++j) {
+					delta += kernel[i * n + j] * solution[j];
+				}
+				leaveOutXBeta[first + i] += delta;
+			}
+		}
+	};
+
+	const int minGroupsPerThread = 1000;
+	const int nThreads = std::max(1, std::min(threads, nGroups / minGroupsPerThread));
+
+	if (nThreads == 1) {
+		leaveOut(0, nGroups);
+	} else {
+		// Groups write disjoint rows of leaveOutXBeta; threads claim the next block as they free up
+		ThreadPool& pool = getStrataPool(nThreads - 1);
+		const int nBlocks = (nGroups + minGroupsPerThread - 1) / minGroupsPerThread;
+		std::atomic<int> next(0);
+		auto work = [&leaveOut,&next,nBlocks,nGroups]() {
+			for (int b = next++; b < nBlocks; b = next++) {
+				leaveOut(b * minGroupsPerThread, std::min(nGroups, (b + 1) * minGroupsPerThread));
+			}
+		};
+
+		std::vector<std::future<void>> futures;
+		for (int t = 1; t < nThreads; ++t) {
+			futures.push_back(pool.enqueue(work));
+		}
+		work();
+		for (auto& future : futures) {
+			future.get();
+		}
+	}
+}
+
 template <class BaseModel,typename RealType>
 void ModelSpecifics<BaseModel,RealType>::computeNumeratorForGradient(int index, bool useWeights) {
 
@@ -1380,6 +2622,43 @@ void ModelSpecifics<BaseModel,RealType>::updateXBeta(double delta, int index, bo
 #endif
 
 	RealType realDelta = static_cast<RealType>(delta);
+	++xBetaVersion;
+
+	if (quadraticApproximation) { // Linear predictor only; no transcendentals until released
+		axpyXBeta(delta, index);
+		return;
+	}
+
+	if (useGramUpdates(useWeights)) {
+		// Gradient is linear in xBeta: shift all known gradients by Hessian column * delta, and
+		// leave xBeta itself to refreshXBeta() when it is next read
+		if (gramColumns[index].empty()) {
+			computeGramColumn(index, useWeights);
+		}
+		const auto& column = gramColumns[index];
+		const RealType scale = static_cast<RealType>(2.0) * realDelta;
+		for (size_t j = 0; j < J; ++j) {
+			if (gramGradientKnown[j]) {
+				gramGradient[j] += scale * column[j];
+			}
+		}
+		if (gramObjectiveKnown) {
+			gramObjective += realDelta * gramXjY[index];
+		}
+		if (gramPendingDelta[index] == static_cast<RealType>(0)) {
+			gramPendingIndices.push_back(index);
+		}
+		gramPendingDelta[index] += realDelta;
+		return;
+	}
+	refreshXBeta();
+	if (gramEnabled) {
+		gramScanned += hX.getNumberOfNonZeroEntries(index);
+		if (!gramMoved[index]) {
+			gramMoved[index] = true;
+			++gramMovedCount;
+		}
+	}
 
 	// Run-time dispatch to implementation depending on covariate FormatType
 	switch(hX.getFormatType(index)) {
@@ -1506,11 +2785,14 @@ void ModelSpecifics<BaseModel,RealType>::computeRemainingStatisticsImpl() {
 
 template <class BaseModel,typename RealType>
 void ModelSpecifics<BaseModel,RealType>::computeRemainingStatistics(bool useWeights) {
+	refreshXBeta();
 
 #ifdef CYCLOPS_DEBUG_TIMING
 	auto start = bsccs::chrono::steady_clock::now();
 #endif
 
+	++xBetaVersion; // offsExpXBeta and denominators are refreshed
+
 	if (useWeights) {
 	    computeRemainingStatisticsImpl<WeightedOperation>();
 	} else {
@@ -1598,25 +2880,61 @@ void ModelSpecifics<BaseModel,RealType>::doSortPid(bool useCrossValidation) {
 }
 
 
+template <class BaseModel,typename RealType>
+ThreadPool& ModelSpecifics<BaseModel,RealType>::getStrataPool(int threads) {
+    if (strataPoolThreads != threads) {
+        strataPool.reset(new ThreadPool(threads));
+        strataPoolThreads = threads;
+    }
+    return *strataPool;
+}
+
 template <class BaseModel,typename RealType> template <typename AnyRealType>
 void ModelSpecifics<BaseModel,RealType>::setPidForAccumulation(const AnyRealType* weights) {
 
-    hPidInternal =  hPidOriginal; // Make copy
-    hPid = hPidInternal.data(); // Point to copy
-    hPidSize = hPidInternal.size();
+    // Layouts depend only on which rows have zero weight
+    std::vector<bool> excluded;
+    uint64_t key = 14695981039346656037ULL; // FNV-1a
+    if (weights != nullptr) {
+        excluded.resize(K);
+        for (size_t k = 0; k < K; ++k) {
+            excluded[k] = (weights[k] == 0.0);
+            key = (key ^ static_cast<uint64_t>(excluded[k])) * 1099511628211ULL;
+        }
+        key ^= 1; // Distinguish from no weights
+    }
+
+    auto layout = accumulationLayouts.find(key);
+    if (layout && layout->excluded == excluded) {
+        accumulationLayout = layout;
+        hPid = layout->pid.data();
+        hPidSize = layout->pid.size();
+        accReset = layout->accReset;
+        N = layout->N;
+        sparseIndices = layout->sparseIndices;
+        return;
+    }
+
+    layout = bsccs::make_shared<AccumulationLayout>();
+    layout->pid = hPidOriginal; // Make copy
+    hPid = layout->pid.data(); // Point to copy
+    hPidSize = layout->pid.size();
     accReset.clear();
 
     const int ignore = -1;
 
     // Find first non-zero weight
     size_t index = 0;
-    while(weights != nullptr && weights[index] == 0.0 && index < K) {
+    while(weights != nullptr && index < K && weights[index] == 0.0) {
         hPid[index] = ignore;
         index++;
     }
 
+    // Readers that store no event times (e.g. the generic command-line format) leave ties undetected
+    const bool hasTime = (hOffs.size() == K);
+
     int lastPid = hPid[index];
-    AnyRealType lastTime = hOffs[index];
+    AnyRealType lastTime = hasTime ? hOffs[index] : 0;
     AnyRealType lastEvent = hY[index];
 
     int pid = hPid[index] = 0;
@@ -1631,13 +2949,13 @@ void ModelSpecifics<BaseModel,RealType>::setPidForAccumulation(const AnyRealType
                 lastPid = nextPid;
             } else {
 
-                if (lastEvent == 1.0 && lastTime == hOffs[k] && lastEvent == hY[k]) {
+                if (hasTime && lastEvent == 1.0 && lastTime == hOffs[k] && lastEvent == hY[k]) {
                     // In a tie, do not increment denominator
                 } else {
                     pid++;
                 }
             }
-            lastTime = hOffs[k];
+            lastTime = hasTime ? hOffs[k] : 0;
             lastEvent = hY[k];
 
             hPid[k] = pid;
@@ -1657,28 +2975,78 @@ void ModelSpecifics<BaseModel,RealType>::setPidForAccumulation(const AnyRealType
         }
     }
     setupSparseIndices(N); // ignore pid == N (pointing to removed data strata)
+
+    layout->excluded.swap(excluded);
+    layout->accReset = accReset;
+    layout->N = N;
+    layout->sparseIndices = sparseIndices;
+
+    size_t bytes = layout->excluded.size() / 8 + sizeof(int) * (layout->pid.size() + accReset.size());
+    for (const auto& indices : sparseIndices) {
+        if (indices) {
+            bytes += sizeof(int) * indices->size();
+        }
+    }
+    accumulationLayouts.insert(key, layout, bytes);
+    accumulationLayout = layout;
 }
 
 template <class BaseModel,typename RealType>
 void ModelSpecifics<BaseModel,RealType>::setupSparseIndices(const int max) {
-    sparseIndices.clear(); // empty if full!
+    sparseIndices.assign(J, IndexVectorPtr()); // empty if full!
 
-    for (size_t j = 0; j < J; ++j) {
+    // Rows are sorted by pid within each column, except for rows pointing past max, so duplicates are adjacent
+    auto column = [this,max](int j) {
         if (hX.getFormatType(j) == DENSE || hX.getFormatType(j) == INTERCEPT) {
-            sparseIndices.push_back(NULL);
-        } else {
-            std::set<int> unique;
-            const size_t n = hX.getNumberOfEntries(j);
-            const int* indicators = hX.getCompressedColumnVector(j);
-            for (size_t j = 0; j < n; j++) { // Loop through non-zero entries only
-                const int k = indicators[j];
-                const int i = (k < hPidSize) ? hPid[k] : k;
-                if (i < max) {
-                    unique.insert(i);
+            return;
+        }
+        const size_t n = hX.getNumberOfEntries(j);
+        const int* indicators = hX.getCompressedColumnVector(j);
+        auto indices = bsccs::make_shared<IndexVector>();
+        indices->reserve(n);
+        bool sorted = true;
+        for (size_t r = 0; r < n; ++r) { // Loop through non-zero entries only
+            const int k = indicators[r];
+            const int i = (k < hPidSize) ? hPid[k] : k;
+            if (i < max) {
+                if (indices->empty() || i > indices->back()) {
+                    indices->push_back(i);
+                } else if (i < indices->back()) {
+                    indices->push_back(i);
+                    sorted = false;
                 }
             }
-            auto indices = bsccs::make_shared<IndexVector>(unique.begin(), unique.end());
-            sparseIndices.push_back(indices);
+        }
+        if (!sorted) {
+            std::sort(indices->begin(), indices->end());
+            indices->erase(std::unique(indices->begin(), indices->end()), indices->end());
+        }
+        indices->shrink_to_fit();
+        sparseIndices[j] = indices;
+    };
+
+    const size_t minRowsPerThread = 100000;
+    const int nThreads = std::max(1, std::min(std::min(threadCount, static_cast<int>(J)),
+                                              static_cast<int>(K / minRowsPerThread)));
+    if (nThreads == 1) {
+        for (size_t j = 0; j < J; ++j) {
+            column(j);
+        }
+    } else {
+        ThreadPool& pool = getStrataPool(nThreads - 1);
+        std::atomic<int> next(0);
+        auto work = [this,&column,&next]() {
+            for (int j = next++; j < static_cast<int>(J); j = next++) {
+                column(j);
+            }
+        };
+        std::vector<std::future<void>> futures;
+        for (int t = 1; t < nThreads; ++t) {
+            futures.push_back(pool.enqueue(work));
+        }
+        work();
+        for (auto& future : futures) {
+            future.get();
         }
     }
 }
@@ -1721,7 +3089,10 @@ void ModelSpecifics<BaseModel,RealType>::initialize(
     }
 
     if (initializeAccumulationVectors()) {
+        accumulationLayouts = LruCache<uint64_t, AccumulationLayout>();
         setPidForAccumulation(static_cast<double*>(nullptr)); // calls setupSparseIndices() before returning
+        accumulationLayoutBytes = accumulationLayouts.getStatistics().bytes + K / 8; // Plus a zero-weight mask
+        setWeightPatternCount(4); // Until a cross-validation driver gives its number of folds
     } else {
         // TODO Suspect below is not necessary for non-grouped data.
         // If true, then fill with pointers to CompressedDataColumn and do not delete in destructor
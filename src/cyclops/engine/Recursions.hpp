@@ -13,6 +13,8 @@
 #include <cstdlib>
 #include <algorithm>
 #include <numeric>
+#include <limits>
+#include <vector>
 
 namespace bsccs {
 
@@ -150,170 +152,167 @@ namespace sugar {
 } // namespace sugar
 
 
-template <typename T, typename SparseIteratorType, typename UIteratorType>//, typename thread_pool> //typename W typename UIteratorType,
+// Howard's recursion for B, the elementary symmetric polynomial of degree numCases in t = exp(x beta), and
+// its first two derivatives along x; returns (1, dB / B, ddB / B). Every degree carries its own binary
+// exponent, so the recursion neither under- nor overflows, and strata with more cases than controls
+// recurse over the controls instead.
+template <typename T, typename SparseIteratorType, typename UIteratorType>
 std::vector<T> computeHowardRecursion(UIteratorType itExpXBeta, SparseIteratorType itX,
-	int numSubjects, int numCases){//, thread_pool &threadPool){//, /*bsccs::real*  */ W caseOrNo) {
-
-    //std::cout<<"starting recursion\n";
-	using namespace sugar;
-	std::vector<T> result;
-	//double caseSum = 0;
-
-	if (numCases==1) {
-		T B = 0;
-		T dB = 0;
-		T ddB = 0;
-		for (int n=0; n<numSubjects; n++) {
-			B += *itExpXBeta;
-			dB += *itExpXBeta * *itX;
-			ddB += *itExpXBeta * *itX * *itX;
-			++itExpXBeta;
-			++itX;
-		}
-		result.push_back(B);
-		result.push_back(dB);
-		result.push_back(ddB);
-	} else {
+	int numSubjects, int numCases) {
+
+	std::vector<T> t(numSubjects);
+	std::vector<T> x(numSubjects);
+	bool hasX = false;
+	T minT = std::numeric_limits<T>::infinity();
+	T maxT = 0;
+	for (int n = 0; n < numSubjects; ++n, ++itExpXBeta, ++itX) {
+		t[n] = *itExpXBeta;
+		x[n] = *itX;
+		hasX = hasX || (x[n] != 0);
+		minT = std::min(minT, t[n]);
+		maxT = std::max(maxT, t[n]);
+	}
 
-	    //std::vector<T> B[2];
-	    // T B[2][3*(numCases+1)];
-	    // B[0][0] = 1;
-	    // B[1][0] = 1;
-	    // for (int i=1; i<=3*numCases+2; i++) {
-	    //     B[0][i] = 0;
-	    //     B[1][i] = 0;
-	    // }
-	 	std::vector<T> B[2];
-	//     B.emplace_back(std::vector<T>(1, static_cast<T>(1)));
-	//     B.emplace_back(std::vector<T>(1, static_cast<T>(1)));
-
-		// std::vector<T> B1;
-		int currentB = 0;
-		// int nThreads = 4;
-
-		B[0].push_back(1);
-		B[1].push_back(1);
-		for (int i=1; i<=3*numCases+2; i++) {
-			B[0].push_back(0);
-			B[1].push_back(0);
-		}
+	std::vector<T> result = {1, 0, 0};
+	if (!hasX || numCases <= 0 || numCases > numSubjects) {
+		return result; // Stratum does not depend on this coefficient
+	}
 
-		int start = 1;
-		int end = 0;
-		// tbb::task_group threadPool;
+	// B(t) = prod(t) B'(1 / t), where B' has degree numSubjects - numCases
+	int m = numCases;
+	T sumX = 0;
+	if (2 * numCases > numSubjects && minT >= std::numeric_limits<T>::min()) {
+		m = numSubjects - numCases;
+		maxT = 0;
+		for (int n = 0; n < numSubjects; ++n) {
+			sumX += x[n];
+			t[n] = 1 / t[n];
+			x[n] = -x[n];
+			maxT = std::max(maxT, t[n]);
+		}
+	}
 
-		//std::future<void> futures[4];
+	// Ratios are invariant to a common scale of t; keep the exponents of t apart, as t / max(t) may underflow
+	std::vector<int> tExponent(numSubjects, 0);
+	int minExponent = 0;
+	if (maxT > 0 && maxT < std::numeric_limits<T>::infinity()) {
+		const int maxExponent = std::ilogb(maxT);
+		for (int n = 0; n < numSubjects; ++n) {
+			if (t[n] > 0) {
+				tExponent[n] = std::ilogb(t[n]);
+				t[n] = std::ldexp(t[n], -tExponent[n]);
+				tExponent[n] -= maxExponent;
+				minExponent = std::min(minExponent, tExponent[n]);
+			}
+		}
+	}
 
-		for (int n=1; n<= numSubjects; n++) {
-			T x = *itX;
-			T t = *itExpXBeta;
-			if (n>numSubjects-numCases+1) start++;
-			if (n<=numCases) end++;
-			// int nloop = end-start+1;
-			//std::cout<<"before"<<B[!currentB][3*start]<<'\n';
-			//std::future<void> futures[4];
-/*
-			for (int i=0; i<nThreads; ++i) {
-			    std::future<void> tempFuture = threadPool.push([x,t,currentB,&B](int id, int tStart,int tEnd){
-			        //futures.push_back(std::move(threadPool.enqueue([=,&B](int tStart,int tEnd){
-			        for (int m=tStart; m<tEnd; m++) {
-			            T b = B[currentB][3*m-3];
-			            T db = B[currentB][3*m-2];
-			            T tb = t*b;
-			            T xtb = x*tb;
-			            T tdb = t*db;
-			            B[!currentB][3*m] = B[currentB][3*m] + tb;
-			            B[!currentB][3*m+1] = B[currentB][3*m+1] + tdb + xtb;
-			            B[!currentB][3*m+2] = B[currentB][3*m+2] + t * B[currentB][3*m-1] + x*xtb + 2*x*tdb;
-			        }
-			    },start+i*nloop/nThreads,start+((i+1)==nThreads?nloop:(t+1)*nloop/nThreads));
-			    //if (tempFuture.valid()) futures[i]=std::move(tempFuture);
-				//futures.emplace_back(tempFuture);
-				//futures.push_back(std::move(tempFuture));
-						//task.wait();
+	T ratio1 = 0;
+	T ratio2 = 0;
+
+	if (m == 0) {
+		// Nothing to recurse over
+	} else if (m == 1) {
+		T b = 0;
+		T db = 0;
+		T ddb = 0;
+		for (int n = 0; n < numSubjects; ++n) {
+			const T xt = x[n] * std::ldexp(t[n], tExponent[n]);
+			b += std::ldexp(t[n], tExponent[n]);
+			db += xt;
+			ddb += x[n] * xt;
+		}
+		ratio1 = db / b;
+		ratio2 = ddb / b;
+	} else {
+		// Mantissas stay within 2^(+/-range) and neighbouring exponents within range of each other,
+		// so each step below is finite
+		const int range = std::numeric_limits<T>::max_exponent / 4;
+		const T upper = std::ldexp(static_cast<T>(1), range);
+		const T lower = std::ldexp(static_cast<T>(1), -range);
+
+		std::vector<T> b(m + 1, 0);
+		std::vector<T> db(m + 1, 0);
+		std::vector<T> ddb(m + 1, 0);
+		std::vector<int> exponent(m + 1, 0);
+		std::vector<T> scale(m + 1, 1); // 2^(exponent[j - 1] - exponent[j])
+		b[0] = 1;
+
+		for (int n = 1; n <= numSubjects; ++n) {
+			const T xn = x[n - 1];
+			const int start = std::max(1, m - (numSubjects - n));
+			const int end = std::min(n, m);
+
+			if (n <= m) { // First visit to degree n
+				exponent[n] = exponent[n - 1];
+				scale[n] = 1;
 			}
- */
-			//std::cout<<threadPool.n_idle() <<" ";
-			// for (int i=0; i<nThreads; i++) {
-				// futures[i].wait();
-			// }
-			// threadPool.clear_queue();
-			//threadPool.stop(true);
-			//std::cout<<"after"<<B[!currentB][3*start]<<'\n';
-
-			//for (int m=std::max(1,n+numCases-numSubjects); m<=std::min(n,numCases);m++) {
-
-
-			// auto func = [&B,x,t,currentB,start,nThreads,nloop](const tbb::blocked_range<int>& range) {
-			// auto func = [&B,x,t,currentB,start,nThreads,nloop](int i) {
-			//
-			//     int tStart = start + i * nloop / nThreads;
-			//     int tEnd = start + ((i + 1) == nThreads ? nloop : (i + 1) * nloop / nThreads);
-			//
-
-			    for (int m = start; m <= end; ++m) {
-			        T b = B[currentB][3*m-3];
-			        T db = B[currentB][3*m-2];
-			        T tb = t*b;
-			        T xtb = x*tb;
-			        T tdb = t*db;
-			        B[!currentB][3*m] = B[currentB][3*m] + tb;
-			        B[!currentB][3*m+1] = B[currentB][3*m+1] + tdb + xtb;
-			        B[!currentB][3*m+2] = B[currentB][3*m+2] + t * B[currentB][3*m-1] + x*xtb + 2*x*tdb;
-			    }
-			// };
-
-
-			// auto func = [&B,x,t,currentB](const tbb::blocked_range<int>& range) {
-			//     for (int m = range.begin(); m < range.end(); ++m) {
-			//         T b = B[currentB][3*m-3];
-			//         T db = B[currentB][3*m-2];
-			//         T tb = t*b;
-			//         T xtb = x*tb;
-			//         T tdb = t*db;
-			//         B[!currentB][3*m] = B[currentB][3*m] + tb;
-			//         B[!currentB][3*m+1] =  B[currentB][3*m+1] + tdb + xtb;
-			//         B[!currentB][3*m+2] = B[currentB][3*m+2] + t * B[currentB][3*m-1] + x*xtb + 2*x*tdb;
-			//     }
-			// };
-			//
-			// tbb::parallel_for(
-			//     tbb::blocked_range<int>(start, end+1), func
-			//     );
-
-
-			currentB = !currentB;
-			++itExpXBeta;
-			++itX;
-			int m = std::min(n,numCases);
-			for (int i=3*m+2; i >= 0; --i) {
-				if (B[currentB][i] > 1e250) {
-					//std::cout<<"resizing"<<'\n';
-					for (int j=0; j<3*numCases+3; ++j) {
-						B[currentB][j] /= 1e250;
+
+			if (minExponent >= -range) {
+				// In place from the top, so degree j - 1 is still from the previous subject
+				const T tn = std::ldexp(t[n - 1], tExponent[n - 1]);
+				for (int j = end; j >= start; --j) {
+					const T ts = tn * scale[j];
+					const T tb = ts * b[j - 1];
+					const T tdb = ts * db[j - 1];
+					ddb[j] += ts * ddb[j - 1] + xn * xn * tb + 2 * xn * tdb;
+					db[j] += tdb + xn * tb;
+					b[j] += tb;
+				}
+			} else if (t[n - 1] > 0) {
+				// Very wide range of t: align each degree with its update, dropping whichever side is negligible
+				for (int j = end; j >= start; --j) {
+					int difference = exponent[j - 1] + tExponent[n - 1] - exponent[j];
+					if (b[j] == 0) {
+						exponent[j] += difference;
+						difference = 0;
+					} else if (difference > range) {
+						const int shift = difference - range;
+						b[j] = std::ldexp(b[j], -shift);
+						db[j] = std::ldexp(db[j], -shift);
+						ddb[j] = std::ldexp(ddb[j], -shift);
+						exponent[j] += shift;
+						difference = range;
 					}
-					break;
+					const T ts = std::ldexp(t[n - 1], difference);
+					const T tb = ts * b[j - 1];
+					const T tdb = ts * db[j - 1];
+					ddb[j] += ts * ddb[j - 1] + xn * xn * tb + 2 * xn * tdb;
+					db[j] += tdb + xn * tb;
+					b[j] += tb;
 				}
 			}
-			/*
-			if (B[currentB][3*m]>1e20 || B[currentB][3*m+1]>1e20 || B[currentB][3*m+2]>1e20) {
-				for (int i=0; i<=numCases; i++) {
-					B[currentB][3*i] /= 1e20;
-					B[currentB][3*i+1] /= 1e20;
-					B[currentB][3*i+2] /= 1e20;
+
+			bool previous = false;
+			for (int j = start; j <= end; ++j) {
+				int shift = 0;
+				const T magnitude = std::abs(b[j]);
+				if (magnitude > upper || (magnitude < lower && magnitude > 0)) {
+					shift = std::ilogb(magnitude);
+				}
+				const int difference = exponent[j - 1] - exponent[j] - shift;
+				if (difference > range && minExponent >= -range) {
+					shift += difference - range;
+				}
+				if (shift != 0) {
+					b[j] = std::ldexp(b[j], -shift);
+					db[j] = std::ldexp(db[j], -shift);
+					ddb[j] = std::ldexp(ddb[j], -shift);
+					exponent[j] += shift;
 				}
+				if (shift != 0 || previous) {
+					scale[j] = std::ldexp(static_cast<T>(1), exponent[j - 1] - exponent[j]);
+				}
+				previous = (shift != 0);
 			}
-			*/
 		}
 
-		result.push_back(B[currentB][3*numCases]);
-		result.push_back(B[currentB][3*numCases+1]);
-		result.push_back(B[currentB][3*numCases+2]);
-
+		ratio1 = db[m] / b[m];
+		ratio2 = ddb[m] / b[m];
 	}
 
-	//result.push_back(maxXi);
-	//result.push_back(maxSorted);
+	result[1] = sumX + ratio1;
+	result[2] = sumX * sumX + 2 * sumX * ratio1 + ratio2;
 
 	return result;
 }
@@ -228,7 +228,7 @@ public:
 		// Do nothing
 	}
 
-	std::string returnFlagString(UpdateReturnFlags flag) {
+	static std::string returnFlagString(UpdateReturnFlags flag) {
 		switch (flag) {
 			case SUCCESS : return "SUCCESS";
 			case MAX_ITERATIONS : return "MAX_ITERATIONS";
@@ -77,7 +77,7 @@ public:
         callback = c;
     }
 
-    bool operator==(const CallbackSharedPtr<T,C>& rhs) noexcept {
+    bool operator==(const CallbackSharedPtr<T,C>& rhs) const noexcept {
         return ptr == rhs.ptr;
     }
 
@@ -124,6 +124,24 @@ struct CacheCallback : public Cachable {
 
 typedef CallbackSharedPtr<double,CacheCallback> VariancePtr;
 
+// Deep copies of variance parameters that preserve which priors share them
+class VarianceMap {
+public:
+    VariancePtr get(const VariancePtr& original) {
+        for (auto& entry : copies) {
+            if (entry.first == original) {
+                return entry.second;
+            }
+        }
+        VariancePtr copy(bsccs::make_shared<double>(original.get()));
+        copies.push_back(std::make_pair(original, copy));
+        return copy;
+    }
+
+private:
+    std::vector<std::pair<VariancePtr,VariancePtr>> copies;
+};
+
 class CovariatePrior; // forward declaration
 typedef bsccs::shared_ptr<CovariatePrior> PriorPtr;
 
@@ -150,6 +168,41 @@ public:
 
 	virtual std::vector<VariancePtr> getVarianceParameters() const = 0 ; // pure virtual
 
+	// Twice-differentiable priors can enter dense Newton steps
+	virtual bool getIsSmooth() const {
+		return false;
+	}
+
+	// Gradient and Hessian of the negative log-density
+	virtual GradientHessian getGradientHessian(const DoubleVector& beta, const int index) const {
+		return GradientHessian(0.0, 0.0);
+	}
+
+	// Identical covariates sharing this prior can be fit as one, with an equal split of the estimate
+	virtual bool getSupportsMerging() const {
+		return false;
+	}
+
+	// Separable penalty of the form getKktBoundary() * |beta|, so that a duality gap can screen covariates
+	virtual bool getSupportsSafeScreening() const {
+		return false;
+	}
+
+	// Lanes are models that differ only in the variance of this prior; getDeltaLanes() gives all their steps at once
+	virtual bool getSupportsLanes() const {
+		return false;
+	}
+
+	virtual void getDeltaLanes(const double* gradient, const double* hessian, const double* beta,
+			const double* variance, const int lanes, double* delta) const {
+		// Do nothing
+	}
+
+	// Copy with private variance parameters; empty if the prior cannot be copied
+	virtual PriorPtr clone(VarianceMap& map) const {
+		return PriorPtr();
+	}
+
 	static PriorPtr makePrior(PriorType priorType, double variance);
 
 	static VariancePtr makeVariance(double variance) {
@@ -187,6 +240,33 @@ public:
 		return -(gh.first / gh.second); // No regularization
 	}
 
+	bool getSupportsLanes() const {
+		return true;
+	}
+
+	void getDeltaLanes(const double* gradient, const double* hessian, const double* beta,
+			const double* variance, const int lanes, double* delta) const {
+		for (int l = 0; l < lanes; ++l) {
+			delta[l] = -(gradient[l] / hessian[l]);
+		}
+	}
+
+	bool getIsSmooth() const {
+		return true;
+	}
+
+	bool getSupportsMerging() const {
+		return true;
+	}
+
+	bool getSupportsSafeScreening() const {
+		return true;
+	}
+
+	PriorPtr clone(VarianceMap& map) const {
+		return bsccs::make_shared<NoPrior>();
+	}
+
 	bool getSupportsKktSwindle() const {
 		return false;
 	}
@@ -272,6 +352,39 @@ public:
 		return delta;
 	}
 
+	bool getSupportsLanes() const {
+		return true;
+	}
+
+	// Branch-free form of getDelta() with lambda taken from each lane's variance
+	void getDeltaLanes(const double* gradient, const double* hessian, const double* beta,
+			const double* variance, const int lanes, double* delta) const {
+		for (int l = 0; l < lanes; ++l) {
+			const double lambda = convertVarianceToHyperparameter(variance[l]);
+			const double negUpdate = - (gradient[l] - lambda) / hessian[l];
+			const double posUpdate = - (gradient[l] + lambda) / hessian[l];
+
+			const double atZero = (negUpdate < 0.0) ? negUpdate : ((posUpdate > 0.0) ? posUpdate : 0.0);
+			const double step = (beta[l] < 0.0) ? negUpdate : posUpdate;
+			const double moved = ((beta[l] + step < 0.0) == (beta[l] < 0.0) && beta[l] + step != 0.0) ?
+				step : -beta[l]; // Do not cross zero
+
+			delta[l] = (beta[l] == 0.0) ? atZero : moved;
+		}
+	}
+
+	bool getSupportsMerging() const {
+		return true; // lambda * |b| is invariant to equal splits of b
+	}
+
+	bool getSupportsSafeScreening() const {
+		return true;
+	}
+
+	PriorPtr clone(VarianceMap& map) const {
+		return bsccs::make_shared<LaplacePrior>(map.get(variance));
+	}
+
 	std::vector<VariancePtr> getVarianceParameters() const {
 	    auto tmp = std::vector<VariancePtr>();
 	    tmp.push_back(variance);
@@ -337,6 +450,10 @@ public:
 
 	virtual ~FusedLaplacePrior() { }
 
+	bool getSupportsLanes() const {
+		return false; // Steps depend on neighbours
+	}
+
 	FusedLaplacePrior(VariancePtr ptr1, VariancePtr ptr2,
 				NeighborList neighborList) : LaplacePrior(ptr1), variance2(ptr2),
 						neighborList(neighborList) {
@@ -357,6 +474,19 @@ public:
 
 	double getDelta(const GradientHessian gh, const DoubleVector& betaVector, const int index) const;
 
+	bool getSupportsMerging() const {
+		return false;
+	}
+
+	bool getSupportsSafeScreening() const {
+		return false;
+	}
+
+	PriorPtr clone(VarianceMap& map) const {
+		return bsccs::make_shared<FusedLaplacePrior>(map.get(getVarianceParameters()[0]), map.get(variance2),
+			neighborList);
+	}
+
 private:
 	double getEpsilon() const {
 		return convertVarianceToHyperparameter(variance2.get());
@@ -414,12 +544,37 @@ public:
 				  (gh.second + (1.0 / sigma2Beta));
 	}
 
+	bool getIsSmooth() const {
+		return true;
+	}
+
+	bool getSupportsLanes() const {
+		return true;
+	}
+
+	void getDeltaLanes(const double* gradient, const double* hessian, const double* beta,
+			const double* variance, const int lanes, double* delta) const {
+		for (int l = 0; l < lanes; ++l) {
+			delta[l] = - (gradient[l] + (beta[l] / variance[l])) /
+					(hessian[l] + (1.0 / variance[l]));
+		}
+	}
+
+	GradientHessian getGradientHessian(const DoubleVector& betaVector, const int index) const {
+		double sigma2Beta = getVariance();
+		return GradientHessian(betaVector[index] / sigma2Beta, 1.0 / sigma2Beta);
+	}
+
 	std::vector<VariancePtr> getVarianceParameters() const {
 	    auto tmp = std::vector<VariancePtr>();
 	    tmp.push_back(variance);
 		return tmp;
 	}
 
+	PriorPtr clone(VarianceMap& map) const {
+		return bsccs::make_shared<NormalPrior>(map.get(variance));
+	}
+
 protected:
     double getVariance() const {
         return variance.get();
@@ -562,12 +717,21 @@ public:
 
     double getDelta(GradientHessian gh, const DoubleVector& betaVector, const int index) const;
 
+    bool getSupportsLanes() const {
+        return false; // Steps depend on neighbours
+    }
+
     std::vector<VariancePtr> getVarianceParameters() const {
         auto tmp = NormalPrior::getVarianceParameters();
         tmp.push_back(variance2);
         return tmp;
     }
 
+    PriorPtr clone(VarianceMap& map) const {
+        return bsccs::make_shared<HierarchicalNormalPrior>(map.get(NormalPrior::getVarianceParameters()[0]),
+            map.get(variance2), neighborList);
+    }
+
 protected:
     double getVariance2() const { return variance2.get(); }
 
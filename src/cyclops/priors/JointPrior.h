@@ -9,6 +9,8 @@
 #define JOINTPRIOR_H_
 
 #include <algorithm>
+#include <map>
+#include <new>
 
 #include "Types.h"
 #include "priors/CovariatePrior.h"
@@ -43,7 +45,36 @@ public:
 
 	virtual double getKktBoundary(const int index) const = 0; // pure virtual
 
-//  	virtual JointPrior* clone() const = 0; // pure virtual
+	virtual bool getIsSmooth(const int index) const {
+		return false;
+	}
+
+	virtual GradientHessian getGradientHessian(const DoubleVector& beta, const int index) const {
+		return GradientHessian(0.0, 0.0);
+	}
+
+	virtual bool getCanMerge(const int indexOne, const int indexTwo) const {
+		return false;
+	}
+
+	virtual bool getSupportsSafeScreening(const int index) const {
+		return false;
+	}
+
+	// Lanes are models that differ only in the (single) variance parameter; see CovariatePrior::getDeltaLanes()
+	virtual bool getSupportsLanes() const {
+		return false;
+	}
+
+	virtual void getDeltaLanes(const double* gradient, const double* hessian, const double* beta,
+			const int index, const double* variance, const int lanes, double* delta) const {
+		// Do nothing
+	}
+
+	// Copy with private variance parameters, so that copies can be tuned concurrently; nullptr if unsupported
+	virtual JointPrior* clone() const {
+		return nullptr;
+	}
 
     void addVarianceParameter(const VariancePtr& ptr) {
         if (std::find(variance.begin(), variance.end(), ptr) == variance.end()) {
@@ -146,6 +177,40 @@ public:
 		return listPriors[index]->getKktBoundary();
 	}
 
+	bool getIsSmooth(const int index) const {
+		return listPriors[index]->getIsSmooth();
+	}
+
+	GradientHessian getGradientHessian(const DoubleVector& beta, const int index) const {
+		return listPriors[index]->getGradientHessian(beta, index);
+	}
+
+	bool getCanMerge(const int indexOne, const int indexTwo) const {
+		return listPriors[indexOne] == listPriors[indexTwo] &&
+			listPriors[indexOne]->getSupportsMerging();
+	}
+
+	bool getSupportsSafeScreening(const int index) const {
+		return listPriors[index]->getSupportsSafeScreening();
+	}
+
+	bool getSupportsLanes() const {
+		if (variance.size() > 1) {
+			return false;
+		}
+		for (auto& prior : uniquePriors) {
+			if (!prior->getSupportsLanes()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void getDeltaLanes(const double* gradient, const double* hessian, const double* beta,
+			const int index, const double* variance, const int lanes, double* delta) const {
+		listPriors[index]->getDeltaLanes(gradient, hessian, beta, variance, lanes, delta);
+	}
+
 	bool getSupportsKktSwindle(void) const {
 		// Return true if *any* prior supports swindle
 		for (auto&prior : uniquePriors) {
@@ -156,45 +221,35 @@ public:
 		return false;
 	}
 
-// 	JointPrior* clone() const {
-// 		PriorList newListPriors(listPriors.size());
-//
-// 	    // Deep copy of variances
-// 	    std::vector<VariancePtr> nVariance;
-// 	    for (auto x : variance) {
-// 	        nVariance.push_back(bsccs::make_shared<double>(*x));
-// 	    }
-//
-// 		PriorList newUniquePriors;
-// 		for (auto& prior : uniquePriors) {
-//
-//             // prior connects to which variances?
-//             auto varianceForPrior = prior->getVarianceParameters();
-//
-//
-// 			PriorPtr newPriorPtr = PriorPtr(prior->clone());
-// 			newUniquePriors.push_back(newPriorPtr);
-// 			for(size_t i = 0; i < listPriors.size(); ++i) {
-// 				if (listPriors[i] == prior) {
-// 					newListPriors[i] = newPriorPtr;
-// 				}
-// 			}
-// 		}
+	JointPrior* clone() const {
+		VarianceMap map;
+		std::map<const CovariatePrior*, PriorPtr> copies;
+		PriorList newUniquePriors;
+		for (auto& prior : uniquePriors) {
+			if (copies.find(&*prior) == copies.end()) {
+				auto copy = prior->clone(map);
+				if (!copy) {
+					return nullptr;
+				}
+				copies[&*prior] = copy;
+			}
+			newUniquePriors.push_back(copies[&*prior]);
+		}
 
-		// CovariatePrior* oldPtr = nullptr;
-// 		for (auto& prior : listPriors) {
-// 			PriorPtr newPriorPtr;
-// 			if (oldPtr == nullptr || oldPtr != &*prior) {
-// 				oldPtr = &*prior;
-// 				newPriorPtr = = PriorPtr(prior->clone());
-// 				newUniquePriors.push_back(newPriorPtr);
-// 			}
-// 			newListPriors.push_back(newPriorPtr);
-// 			std::cerr << "cloned " << &*prior* << " -> " << &*newPriorPtr << std::endl;
-// 		}
-//
-// 		return new MixtureJointPrior(newListPriors, newUniquePriors);
-// 	}
+		PriorList newListPriors;
+		newListPriors.reserve(listPriors.size());
+		for (auto& prior : listPriors) {
+			newListPriors.push_back(copies[&*prior]);
+		}
+
+		auto joint = new (std::nothrow) MixtureJointPrior(newListPriors, newUniquePriors);
+		if (joint != nullptr) {
+			for (auto& ptr : variance) {
+				joint->addVarianceParameter(map.get(ptr));
+			}
+		}
+		return joint;
+	}
 
 private:
 
@@ -637,14 +692,46 @@ public:
 		return singlePrior->getKktBoundary();
 	}
 
-// 	JointPrior* clone() const {
-// 	    std::vector<VariancePtr> newPtrs;
-// 	    for (auto x : variance) {
-// 	        newPtrs.push_back(bsccs::make_shared<double>(*x)); // deep copy of variances
-// 	    }
-//
-// 		return new FullyExchangeableJointPrior(PriorPtr(singlePrior->clone(newPtrs)));
-// 	}
+	bool getIsSmooth(const int index) const {
+		return singlePrior->getIsSmooth();
+	}
+
+	GradientHessian getGradientHessian(const DoubleVector& beta, const int index) const {
+		return singlePrior->getGradientHessian(beta, index);
+	}
+
+	bool getCanMerge(const int indexOne, const int indexTwo) const {
+		return singlePrior->getSupportsMerging();
+	}
+
+	bool getSupportsSafeScreening(const int index) const {
+		return singlePrior->getSupportsSafeScreening();
+	}
+
+	bool getSupportsLanes() const {
+		return variance.size() <= 1 && singlePrior->getSupportsLanes();
+	}
+
+	void getDeltaLanes(const double* gradient, const double* hessian, const double* beta,
+			const int index, const double* variance, const int lanes, double* delta) const {
+		singlePrior->getDeltaLanes(gradient, hessian, beta, variance, lanes, delta);
+	}
+
+	JointPrior* clone() const {
+		VarianceMap map;
+		auto copy = singlePrior->clone(map);
+		if (!copy) {
+			return nullptr;
+		}
+		auto joint = new (std::nothrow) FullyExchangeableJointPrior(copy);
+		if (joint != nullptr) {
+			joint->variance.clear();
+			for (auto& ptr : variance) {
+				joint->addVarianceParameter(map.get(ptr));
+			}
+		}
+		return joint;
+	}
 
 private:
 
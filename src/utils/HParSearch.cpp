@@ -119,6 +119,33 @@ StepValue UniModalSearch::step() //recommend: do/not next step, and the next x v
     return ret;
 }
 
+//speculate up to count values that step() may ask for next; the first is always next.second
+std::vector<double> UniModalSearch::batch( const StepValue& next, int count ) const
+{
+    std::vector<double> points(1, next.second);
+    if( !next.first || count <= 1 )  return points;
+
+    const bool bracketed = y_by_x.size() >= 3
+        && y_by_x.begin()->first != best->first && y_by_x.rbegin()->first != best->first;
+    if( bracketed )  return points; //the quadratic step depends on values not yet known
+
+    //while the max sits at a boundary step() keeps moving outwards; with two values it may instead turn back
+    const bool up = y_by_x.empty() ? next.second < m_first_cut : next.second > y_by_x.rbegin()->first;
+    const double first = y_by_x.empty() ? next.second : y_by_x.begin()->first;
+    bool canTurn = y_by_x.size() <= 1;
+
+    double ahead = next.second;
+    while( (int)points.size() < count ) {
+        ahead = up ? ahead * m_stdstep : ahead / m_stdstep;
+        points.push_back( ahead );
+        if( canTurn && (int)points.size() < count ) {
+            points.push_back( up ? first / m_stdstep : first * m_stdstep );
+            canTurn = false;
+        }
+    }
+    return points;
+}
+
 //void UniModalSearch::dump(std::ostream& stream) const {
 //    int i = 0;
 //    for (map<double,UniModalSearch::MS>::const_iterator itr=y_by_x.begin(); itr!=y_by_x.end();
@@ -2,6 +2,7 @@
 #define HYPER_PARAMETER_SEARCH_HPP_
 
 #include <map>
+#include <vector>
 /*#include <ostream>
 #include <string>
 #include <sstream>
@@ -47,6 +48,7 @@ public:
         }
     }
     StepValue step(); // recommend: do/not next step, the next x value
+    std::vector<double> batch( const StepValue& next, int count ) const; // next x value plus candidates to try concurrently
     //ctor
     UniModalSearch( double stdstep=100, double stop_by_y=.01, double stop_by_x=log(1.5),
         double firstCut=1.0 )
@@ -73,12 +73,73 @@ public:
 		return Coordinate(x1, obj1);
 	}
 
+	// Safeguarded Newton search for the sign change beyond x0 in direction, starting at x1.
+	// Assumes that objective() > 0 at x0 and that obj.derivative() is the slope at the last
+	// objective() evaluation.  Once bracketed, steps leaving the bracket fall back to secant
+	// and then bisection.
+	double findRoot(double x0, double obj0, double direction, double x1) {
+		double xIn = x0;
+		double objIn = obj0;
+		double xOut = NAN;
+		double objOut = NAN;
+		double width = NAN;
+
+		double x = x1;
+		int expansions = 0;
+
+		for (it = 0; it < maxIt; ++it) {
+			const double y = obj.objective(x);
+			if (std::isnan(y)) {
+				return y;
+			}
+			const double slope = obj.derivative();
+
+			if (y > 0) {
+				xIn = x;
+				objIn = y;
+			} else {
+				xOut = x;
+				objOut = y;
+			}
+
+			double next = (slope != 0.0) ? x - y / slope : NAN;
+
+			if (!std::isnan(xOut)) { // Bracketed
+				const double lower = std::min(xIn, xOut);
+				const double upper = std::max(xIn, xOut);
+				const double lastWidth = width;
+				width = upper - lower;
+
+				if (!(next > lower && next < upper)) {
+					next = xIn - objIn * (xOut - xIn) / (objOut - objIn);
+					if (!(next > lower && next < upper) || width > 0.5 * lastWidth) {
+						next = 0.5 * (lower + upper);
+					}
+				}
+			} else if (!((next - xIn) * direction > 0.0)) {
+				next = x0 + 2.0 * (x - x0);  // Still inside and the slope does not point out; expand
+				if (++expansions > maxExpansions) {
+					return NAN;
+				}
+			}
+
+			if (std::abs(next - x) < tol) {
+				return next;
+			}
+			x = next;
+		}
+		it = -1;
+		return NAN;
+	}
+
 	double getTolerance() { return tol; }
 
 	int getIterations() { return it; }
 
 private:
 
+	static const int maxExpansions = 20; // Doublings of the step before findRoot() gives up on a bracket
+
 	Obj& obj;
 	double tol;
 	int maxIt;
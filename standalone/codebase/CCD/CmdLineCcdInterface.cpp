@@ -106,15 +106,41 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 		ValuesConstraint<std::string> allowedConvergenceValues(allowedConvergence);
 		ValueArg<string> convergenceArg("", "convergence", "Convergence criterion", false, arguments.modeFinding.convergenceTypeString, &allowedConvergenceValues);
 
+		std::vector<std::string> allowedSelection;
+		allowedSelection.push_back("cyclic");
+		allowedSelection.push_back("random");
+		allowedSelection.push_back("greedy");
+		allowedSelection.push_back("hybrid");
+		ValuesConstraint<std::string> allowedSelectionValues(allowedSelection);
+		ValueArg<string> selectionArg("", "selection", "Coordinate selection schedule", false, "cyclic", &allowedSelectionValues);
+		ValueArg<double> hybridFractionArg("", "hybridFraction", "Fraction of each cycle reserved for top violators under hybrid selection", false, arguments.modeFinding.hybridFraction, "real");
+
+		std::vector<std::string> allowedAlgorithms;
+		allowedAlgorithms.push_back("ccd");
+		allowedAlgorithms.push_back("mm");
+		allowedAlgorithms.push_back("newton");
+		allowedAlgorithms.push_back("fista");
+		allowedAlgorithms.push_back("irls");
+		ValuesConstraint<std::string> allowedAlgorithmValues(allowedAlgorithms);
+		ValueArg<string> algorithmArg("", "algorithm", "Mode-finding algorithm", false, "ccd", &allowedAlgorithmValues);
+		ValueArg<int> newtonThresholdArg("", "newtonThreshold", "Use dense Newton steps when at most this many covariates are estimated, 0 disables", false, arguments.modeFinding.newtonThreshold, "int");
+		ValueArg<int> gramThresholdArg("", "gramThreshold", "Use cached covariate inner products for least-squares gradients when at most this many covariates, 0 disables, -1 chooses from the design size", false, arguments.modeFinding.gramThreshold, "int");
+		SwitchArg safeScreeningArg("", "safeScreening", "Drop Laplace-prior covariates proven zero by a duality-gap bound", arguments.modeFinding.useSafeScreening);
+		ValueArg<int> crossTermCacheSizeArg("", "crossTermCacheSize", "Megabytes of per-stratum cross terms kept for Fisher information", false, arguments.modeFinding.crossTermCacheSize, "int");
+		ValueArg<int> qnArg("", "qn", "Number of secant pairs for quasi-Newton acceleration, 0 disables", false, arguments.modeFinding.qnQ, "int");
+
 		ValueArg<long> seedArg("s", "seed", "Random number generator seed", false, arguments.seed, "long");
+		ValueArg<int> threadsArg("", "threads", "Number of threads for cross-validation, -1 uses all cores", false, arguments.threads, "int");
 
 		// Cross-validation arguments
 		SwitchArg doCVArg("c", "cv", "Perform cross-validation selection of hyperprior variance", arguments.crossValidation.doCrossValidation);
 		SwitchArg useAutoSearchCVArg("", "auto", "Use an auto-search when performing cross-validation", arguments.crossValidation.useAutoSearchCV);
+		SwitchArg useApproximateLeaveOutArg("", "alo", "Score the cross-validation grid by approximate leave-one-out", arguments.crossValidation.useApproximateLeaveOut);
 		ValueArg<double> lowerCVArg("l", "lower", "Lower limit for cross-validation search", false, arguments.crossValidation.lowerLimit, "real");
 		ValueArg<double> upperCVArg("u", "upper", "Upper limit for cross-validation search", false, arguments.crossValidation.upperLimit, "real");
 		ValueArg<int> foldCVArg("f", "fold", "Fold level for cross-validation", false, arguments.crossValidation.fold, "int");
 		ValueArg<int> gridCVArg("", "gridSize", "Uniform grid size for cross-validation search", false, arguments.crossValidation.gridSteps, "int");
+		ValueArg<int> gridLanesCVArg("", "gridLanes", "Grid-points fit together in one pass over each fold", false, arguments.crossValidation.gridLanes, "int");
 		ValueArg<int> foldToComputeCVArg("", "computeFold", "Number of fold to iterate, default is 'fold' value", false, arguments.crossValidation.foldToCompute, "int");
 		ValueArg<string> outFile2Arg("", "cvFileName", "Cross-validation output file name", false, arguments.crossValidation.cvFileName, "cvFileName");
 
@@ -123,7 +149,9 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 //		ValueArg<string> bsOutFileArg("", "bsFileName", "Bootstrap output file name", false, "bs.txt", "bsFileName");
 		ValueArg<int> replicatesArg("r", "replicates", "Number of bootstrap replicates", false, arguments.replicates, "int");
 		SwitchArg reportRawEstimatesArg("","raw", "Report the raw bootstrap estimates", arguments.reportRawEstimates);
+		MultiArg<long> rawCovariateArg("", "rawCovariate", "Report raw bootstrap estimates only for covariate", false, "integer");
 		ValueArg<int> partialArg("", "partial", "Number of rows to use in partial estimation", false, -1, "int");
+		MultiArg<double> subsampleArg("", "subsample", "Proportion of data to fit as a warm start before the full-data fit", false, "real");
 
 		// Model arguments
 //		SwitchArg doLogisticRegressionArg("", "logistic", "Use ordinary logistic regression", arguments.doLogisticRegression);
@@ -177,7 +205,16 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 		cmd.add(reportASEArg);
 //		cmd.add(zhangOlesConvergenceArg);
 		cmd.add(convergenceArg);
+		cmd.add(selectionArg);
+		cmd.add(hybridFractionArg);
+		cmd.add(qnArg);
+		cmd.add(algorithmArg);
+		cmd.add(newtonThresholdArg);
+		cmd.add(gramThresholdArg);
+		cmd.add(safeScreeningArg);
+		cmd.add(crossTermCacheSizeArg);
 		cmd.add(seedArg);
+		cmd.add(threadsArg);
 		cmd.add(modelArg);
 		cmd.add(formatArg);
 		cmd.add(outputFormatArg);
@@ -191,10 +228,12 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 
 		cmd.add(doCVArg);
 		cmd.add(useAutoSearchCVArg);
+		cmd.add(useApproximateLeaveOutArg);
 		cmd.add(lowerCVArg);
 		cmd.add(upperCVArg);
 		cmd.add(foldCVArg);
 		cmd.add(gridCVArg);
+		cmd.add(gridLanesCVArg);
 		cmd.add(foldToComputeCVArg);
 		cmd.add(outFile2Arg);
 		cmd.add(outDirectoryNameArg);
@@ -203,7 +242,9 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 //		cmd.add(bsOutFileArg);
 		cmd.add(replicatesArg);
 		cmd.add(partialArg);
+		cmd.add(subsampleArg);
 		cmd.add(reportRawEstimatesArg);
+		cmd.add(rawCovariateArg);
 //		cmd.add(doLogisticRegressionArg);
 
 		cmd.add(quietArg);
@@ -231,6 +272,8 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 		arguments.fitMLEAtMode = computeMLEAtModeArg.getValue();
 		arguments.reportASE = reportASEArg.getValue();
 		arguments.seed = seedArg.getValue();
+		arguments.modeFinding.seed = arguments.seed;
+		arguments.threads = threadsArg.getValue();
 
 		//Hierarchy arguments
 		arguments.useHierarchy = useHierarchyArg.isSet();
@@ -278,14 +321,43 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 			exit(-1);
 		}
 
+		if (selectionArg.getValue() == "random") {
+			arguments.modeFinding.coordinateSelection = CoordinateSelectionType::RANDOM;
+		} else if (selectionArg.getValue() == "greedy") {
+			arguments.modeFinding.coordinateSelection = CoordinateSelectionType::GREEDY;
+		} else if (selectionArg.getValue() == "hybrid") {
+			arguments.modeFinding.coordinateSelection = CoordinateSelectionType::HYBRID;
+		} else {
+			arguments.modeFinding.coordinateSelection = CoordinateSelectionType::CYCLIC;
+		}
+		arguments.modeFinding.hybridFraction = hybridFractionArg.getValue();
+		arguments.modeFinding.qnQ = qnArg.getValue();
+		if (algorithmArg.getValue() == "mm") {
+			arguments.modeFinding.algorithmType = AlgorithmType::MM;
+		} else if (algorithmArg.getValue() == "newton") {
+			arguments.modeFinding.algorithmType = AlgorithmType::NEWTON;
+		} else if (algorithmArg.getValue() == "fista") {
+			arguments.modeFinding.algorithmType = AlgorithmType::FISTA;
+		} else if (algorithmArg.getValue() == "irls") {
+			arguments.modeFinding.algorithmType = AlgorithmType::IRLS;
+		} else {
+			arguments.modeFinding.algorithmType = AlgorithmType::CCD;
+		}
+		arguments.modeFinding.newtonThreshold = newtonThresholdArg.getValue();
+		arguments.modeFinding.gramThreshold = gramThresholdArg.getValue();
+		arguments.modeFinding.useSafeScreening = safeScreeningArg.getValue();
+		arguments.modeFinding.crossTermCacheSize = crossTermCacheSizeArg.getValue();
+
 		// Cross-validation
 		arguments.crossValidation.doCrossValidation = doCVArg.isSet();
 		if (arguments.crossValidation.doCrossValidation) {
 			arguments.crossValidation.useAutoSearchCV = useAutoSearchCVArg.isSet();
+			arguments.crossValidation.useApproximateLeaveOut = useApproximateLeaveOutArg.isSet();
 			arguments.crossValidation.lowerLimit = lowerCVArg.getValue();
 			arguments.crossValidation.upperLimit = upperCVArg.getValue();
 			arguments.crossValidation.fold = foldCVArg.getValue();
 			arguments.crossValidation.gridSteps = gridCVArg.getValue();
+			arguments.crossValidation.gridLanes = gridLanesCVArg.getValue();
 			if(foldToComputeCVArg.isSet()) {
 				arguments.crossValidation.foldToCompute = foldToComputeCVArg.getValue();
 			} else {
@@ -300,7 +372,10 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 		if (arguments.doBootstrap) {
 //			arguments.bsFileName = bsOutFileArg.getValue();
 			arguments.replicates = replicatesArg.getValue();
-			if (reportRawEstimatesArg.isSet()) {
+			for (int i = 0; i < rawCovariateArg.getValue().size(); ++i) {
+			    arguments.rawEstimates.push_back(rawCovariateArg.getValue()[i]);
+			}
+			if (reportRawEstimatesArg.isSet() || !arguments.rawEstimates.empty()) {
 				arguments.reportRawEstimates = true;
 			} else {
 				arguments.reportRawEstimates = false;
@@ -312,6 +387,8 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 			arguments.replicates = partialArg.getValue();
 		}
 
+		arguments.subsampleProportions = subsampleArg.getValue();
+
 		if (quietArg.getValue()) {
 			arguments.noiseLevel = QUIET;
 		}